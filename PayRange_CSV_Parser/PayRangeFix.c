@@ -1,834 +1,6591 @@
-/*
-    This program was designed by Alex Arwin
-    a current employee of Gator Vending
-    for use solely by Gator Vending, Inc.
-    It's sole purpose is designed to minimize the
-    grunt work it currently takes to process a
-    weekly PayRange Report.
-
-    Current Method:
-        Download File
-        Manually extract useful information
-        Manually adjust columns/rows to readily show information
-        Manually total columns with same Display Names
-        Enter into our accounting software
-
-    Goal Method:
-        Download File
-        Run .exe
-        Enter into our accounting software
-
-    Assumptions Made:
-        The Downloaded PayRange File does not significantly change format styles over time
-        The Number of Rows in the PayRange File is not extremely large(excess of 1000)
-            --This is mentioned because the methods used to extract, parse, and sort
-              the data is not exactly efficient and I am okay with this as the data set
-              is never expected to grow much larger than 500 lines.
-        No Line in the PayRange File is longer than 200 characters
-        No Display Name is longer than 80 characters.
-            --These numbers were chosen after carefully examining the file being parsed in
-              its original form. They allow some minor expansion to occur without causing
-              a parsing problem.
-
-    Note(s):
-        The Data Structure being implemented is Linked Lists
-        The Sorting Algorithm is Bubble Sort
-        The <zstring.h> is a custom library created with a sole
-            purpose of fixing many of the pitfalls the more
-            common <string.h> standard library experiences. More specifically
-            I make use of it to avoid skipping tokens with no values
-            (like strtok()) currently does. This allows me to account
-            for columns that are blank/empty.
-
-*/
-//Header & Library File(s)
-#include <stdbool.h>
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include "zstring.h"
-
-//Constant(s)
-#define NOTVERIFIED -1
-#define VERIFIED 1
-#define MAX_STRING_LEN 80
-#define MAX_CSV_LEN 200
-
-//Struct(s)
-typedef struct row
-{
-    char dName[MAX_STRING_LEN]; //Name of PayRange Location
-    char mobileAmt[MAX_STRING_LEN]; //Raw Amount Before Reductions
-    char feeAmt[MAX_STRING_LEN]; //Fee Amt (%-baseD)
-    char discountAmt[MAX_STRING_LEN];//Amt of Discounts Given
-    char netAmt[MAX_STRING_LEN]; //Net Amt after Discount & Fee
-    float totalAmt; //Total Amt used to total accounts (Mobile minus Discounts)
-
-    struct row* next; //pointer to next item in LL
-} row;
-
-//Global Variable(s)
-char filename[MAX_STRING_LEN];
-const char comma[2] = ",";
-const char dName[13] = "Display Name";
-const char mobileAmt[7] = "Mobile";
-const char discountAmt[10] = "Discounts";
-const char feeAmt[4] = "Fee";
-const char netAmt[6] = "Net\n";
-
-/*
-For this program to work dynamically with PayRange
-we need to search the headers and assign what column the data
-we're looking for is in so we can skip extraneous data and only
-store the desired data
-*/
-int col_pos_dName;
-int col_pos_mobileAmt;
-int col_pos_discountAmt;
-int col_pos_feeAmt;
-int col_pos_netAmt;
-int totalColumns = 0;
-int totalNodes = 0;
-
-struct row* root = NULL;//Root of the Linked List. No Mobile,Discount, but Fee Exists, Keep these seperate.
-struct row* head = NULL;//Head of the Linked List
-
-//Function Declaration(s)/Prototype(s)
-void run(void);
-void verifyFileName(void);
-void parseHeaders(void);
-void parsePayRangeFile(void);
-void alternativeSort(void);
-void writePayRangeFile(void);
-void printHeaders(FILE*);
-void printRows(FILE*, struct row*);
-void printTotal(FILE*);
-void freeList(struct row*);
-
-//--Used to Debug During Development
-void showHead(void);
-void showNode(struct row*);
-void showList(void);
-void countPause(int);
-
-//--Helper Functions
-void nullify(struct row*);
-char* concat(const char*, const char*);
-void removeNoCashNodes(void);
-bool isLetter(char);
-bool isNextMatch(char [MAX_STRING_LEN], char [MAX_STRING_LEN]);
-bool moneyExists(struct row*);
-bool moneyCheck(char [MAX_STRING_LEN]);
-float strToFloat(char [MAX_STRING_LEN], char [MAX_STRING_LEN]);
-char* removeNewLine(char [MAX_STRING_LEN]);
-
-//Main
-int main(int argc, char *argv[])
-{
-    // NOTE ARGC = Argument Count && Argv = Argument Vector
-    //filename = *argv[0];
-
-    /*
-    strcpy(filename, "PayRange417to423");
-    run();
-    system("pause");
-
-    strcpy(filename, "PayRange424to430");
-    run();
-    system("pause");
-
-    strcpy(filename, "PayRange51to57");
-    run();
-    system("pause");
-
-    strcpy(filename, "PayRange58to514");
-    run();
-    */
-
-    strcpy(filename, "test1234");
-    run();
-
-    return;
-}//END main
-
-//Function(s)
-void run()
-{
-    printf("Verifying File Exists...\n");
-    verifyFileName();
-
-    printf("Reading Column Headers...\n");
-    parseHeaders();
-
-    printf("Parsing File Now...\n");
-    parsePayRangeFile();
-
-    printf("Sorting File Now...\n");
-    alternativeSort();
-
-    printf("Creating New File...\n");
-    writePayRangeFile();
-
-    printf("Completed! Check new file and rename it!\n");
-
-    return;
-}
-
-void verifyFileName()
-{
-    //Local Variable(s)
-    int flag = NOTVERIFIED;
-    char str[MAX_STRING_LEN];
-    FILE* stream;
-    char *s;
-
-    while(flag == NOTVERIFIED)
-    {
-        s = concat(filename, ".csv");
-        stream = fopen(s, "r"); //Attempt to Open File
-
-        if(stream == NULL) //If failed to open file
-        {
-            fclose(stream); //Close the file
-
-            printf("Error: File failing to open.\nPlease verify the name is correct and try again: ");
-            gets(str); //Ask for correct filename && try again
-            strcpy(filename, str);
-            printf("\n");
-        }
-        else
-        {
-            printf("File Found...\n");
-            fclose(stream); //Close the file
-            flag = VERIFIED;
-        }
-    }
-
-    return;
-}//END verifyFileName
-
-void parseHeaders()
-{
-    //Local Variable(s)
-    char str[MAX_CSV_LEN];
-    char *token, *s;
-    FILE* stream;
-    int col = 0;
-
-    s = concat(filename, ".csv");
-    stream = fopen(s, "r"); //Open File
-    fgets(str, MAX_CSV_LEN, stream); //Get First Line (column headers)
-
-    token = strtok(str, comma); //Grab First Token from First Line String (delimited by commas)
-
-    while(token != NULL) //while there are tokens remaining
-    {
-        col++;
-
-        if(strcmp(token, dName) == 0)
-        {
-            col_pos_dName = col; //retain col # of dName header
-        }
-        else if(strcmp(token, mobileAmt) == 0)
-        {
-            col_pos_mobileAmt = col; //retain col # of mobileAmt header
-        }
-        else if(strcmp(token, discountAmt) == 0)
-        {
-            col_pos_discountAmt = col; //retain col # of discountAmt header
-        }
-        else if(strcmp(token, feeAmt) == 0)
-        {
-            col_pos_feeAmt = col; //retain col # of feeAmt header
-        }
-        else if(strcmp(token, netAmt) == 0)
-        {
-            col_pos_netAmt = col; //retain col # of netAmt header
-        }
-
-        token = strtok(NULL, comma); //get next token
-    }
-
-    totalColumns = col;//Retain total amount of columns seen in the file
-
-    fclose(stream); //Close File
-
-    return;
-}//END parseHeaders
-
-void nullify(struct row* temp)
-{
-    strcpy(temp->dName,"\0");
-    strcpy(temp->mobileAmt,"\0");
-    strcpy(temp->discountAmt, "\0");
-    strcpy(temp->feeAmt, "\0");
-    strcpy(temp->netAmt,"\0");
-
-    return;
-}
-
-void parsePayRangeFile()
-{
-    //Local Variable(s)
-    FILE* stream;
-    char str[MAX_CSV_LEN];
-    char *token, *s;
-    int currCol = 2;//Once we grab a line with data we're interested in, we'll actually be in column two (based on csv file format)
-    int initialNode = NOTVERIFIED;
-    struct row* temp = (struct row*)malloc(sizeof(struct row));
-
-    s = concat(filename,".csv");
-    stream = fopen(s, "r"); //Open File
-    fgets(str, MAX_CSV_LEN, stream); //Get First Line (discard, do not need as it is only headers)
-
-    while(fgets(str, MAX_CSV_LEN, stream) != NULL)//while there are lines left to read, get one.
-    {
-        while(strlen(str) < MAX_STRING_LEN)
-        {
-            fgets(str, MAX_CSV_LEN, stream); //skip this line, not what we're looking for
-        }
-
-        token = zstring_strtok(str, comma); //Get First Token from newly grabbed line from file
-
-        while(token != NULL) //while there are tokens remaining
-        {
-                /* Determine if the current column is data we need, and store it accordingly */
-                if(currCol == col_pos_dName)
-                    strcpy(temp->dName, token);
-                else if(currCol == col_pos_mobileAmt)
-                    strcpy(temp->mobileAmt, token);
-                else if(currCol == col_pos_discountAmt)
-                    strcpy(temp->discountAmt, token);
-                else if(currCol == col_pos_feeAmt)
-                    strcpy(temp->feeAmt, token);
-                else if(currCol == col_pos_netAmt)
-                    strcpy(temp->netAmt, removeNewLine(token));
-
-            if(currCol == totalColumns)//found last item for this node, save it and create new node
-            {
-                //showNode(temp);
-
-                if(moneyExists(temp))//Only add node to list if it has money
-                {
-                    //Change the String: '$x.xx' to a float value, used when writing new csv file
-                    temp->totalAmt = strToFloat(temp->mobileAmt,temp->discountAmt);
-
-                    if(initialNode == NOTVERIFIED)
-                    {
-                        //printf("\nAdding Head Now!");
-                        temp->next = (struct row*)malloc(sizeof(struct row)); //Allocate Mem for Next Node
-                        head = temp;//link head to the first node created and assigned
-                        temp = temp->next;//move temp to newly created blank node
-
-                        initialNode = VERIFIED;//mark first(head) node as verified
-                    }
-                    else
-                    {
-                        //printf("\nAdding Middle of List Now!");
-                        temp->next = (struct row*)malloc(sizeof(struct row)); //Allocate Mem for Next Node
-                        temp = temp->next;
-                    }
-                }
-                else
-                {
-                    //printf("\nNot Adding Node Now!");
-                }
-
-                currCol = 2; //reset counter
-                token = NULL;//reset our token
-                totalNodes++;//increment our totalNodes(total rows) counter
-
-            }
-            else
-            {
-                token = zstring_strtok(NULL, comma); //get next token
-                currCol++; //adjust column over
-            }
-        }
-    }
-
-
-    return;
-}//End parsePayRangeFile
-
-void alternativeSort()
-{
-    showList();
-    /*
-    strcmp(s1,s2)
-
-    strcmp returns neg int if stop char in s1 was LESS than in s2 (s1 < s2) s1 stopping char was closer to a than s2
-           returns pos int if stop char in s1 was MORE than in s2 (s1 > s2) s2 stopping char was closer to a then s1
-           returns 0 if equal
-
-           ASCII
-           65(A) to 90(Z)
-           97(a) to 122(z)
-           (difference of 32)
-    */
-
-    //Local Variable(s)
-    struct row* temp;      //Used to avoid chance of losing HEAD
-    struct row* prevHold;  //Used to retain location of the previous node to use during swapping
-    struct row* hold;      //Used to store data that needs to be saved when swapping
-    bool swapOccured = true;
-    bool beginFlag;
-
-    while(swapOccured == true)//while a swap was made in the prev iteration
-    {
-        beginFlag = true;
-        swapOccured = false;
-        temp = head;
-
-        while(temp->next != NULL) //while not at end of list
-        {
-            //Case 1: Swap Needed
-            if((strcmp(temp->dName,temp->next->dName)) > 0)//indicates the first node is lower in alphabet then second, swap needed
-            {
-                if(beginFlag == true)//Case 1: Head of List
-                {
-                    head = temp->next;//Move Head Pointer to newly swapped Node
-                    prevHold = temp->next;//Maintain location of one node back so we can set its next ptr when swapping
-                    temp->next = temp->next->next;//Curr Node now points to TWO Ahead
-                    head->next = temp;//Ahead now points to Curr
-                    swapOccured = true; //Set Swap Flag
-                    beginFlag = false; //Set head of list flag
-                }
-                else if(temp->next->next == NULL)//Case 2: Next Node is the last node in list
-                {
-                    hold = temp->next;
-                    prevHold->next = temp->next;
-                    temp->next= NULL;
-                    hold->next = temp;
-                }
-                else//Case 3: Middle of List
-                {
-                    hold = temp->next;
-                    prevHold->next = temp->next;
-                    prevHold = temp->next;//Maintain location of one node back so we can set its next ptr when swapping
-                    temp->next = temp->next->next;//Curr Node now points to TWO Ahead
-                    hold->next = temp;//Ahead now points to Curr
-                    swapOccured = true; //Set Swap Flag
-                }
-            }
-            //Case 2: Swap NOT Needed
-            else
-            {
-                prevHold = temp;
-                temp = temp->next;//Go to next node
-                beginFlag = false; //Set head of list flag
-            }
-        }
-    }
-
-    return;
-}
-
-void writePayRangeFile()
-{
-    //Local Variable(s)
-    FILE* stream;
-    struct row* temp = head;  //temp used to avoid loss of head pointer
-    char* s = concat(filename, "_parsed.csv");
-
-    stream = fopen(s, "w"); //Open a new file to write proper data into
-
-    //PRINT HEADERS INTO FILE
-    printHeaders(stream);
-    printRows(stream, temp);
-    printTotal(stream);
-
-    fclose(stream);
-
-    freeList(head);
-    free(s);
-    return;
-
-}//END writePayRangeFile
-
-void printHeaders(FILE* stream)
-{
-    fprintf(stream, "Display Name,");
-    fprintf(stream, "Mobile,");
-    fprintf(stream, "Discounts,");
-    fprintf(stream, "Fee,");
-    fprintf(stream, "Net,");
-    fprintf(stream, "Total\n");
-    return;
-}//END printHeaders
-
-void printRows(FILE* stream, struct row* temp)
-{
-    showHead();
-    system("pause");
-    int flag = NOTVERIFIED;   //flag for end of list
-    float totalAmt= 0.00;     //used to store total amounts between nodes of the same account
-
-    while(flag == NOTVERIFIED)
-    {
-        fprintf(stream, temp->dName); fprintf(stream, ",");//Write Display Name & Comma
-        fprintf(stream, temp->mobileAmt); fprintf(stream, ",");//Write Mobile Amt & Comma
-        fprintf(stream, temp->discountAmt);fprintf(stream, ",");//Write Discount Amt & Comma
-        fprintf(stream, temp->feeAmt); fprintf(stream, ",");//Write Fee Amt & Comma
-        fprintf(stream, temp->netAmt); fprintf(stream, ",");//Write Net Amt & Comma
-
-
-        if(temp->next != NULL)//If there are still more items to come &
-        {
-            if(isNextMatch(temp->dName,temp->next->dName))//CurrName & NextName Match, don't write total
-            {
-                fprintf(stream, "\n");
-                totalAmt += temp->totalAmt;
-            }
-            else//not a match, write total
-            {
-                totalAmt += temp->totalAmt;
-                fprintf(stream, "$%.2f\n", totalAmt);
-                totalAmt = 0.00;
-            }
-        }
-        else//at last node, write total
-        {
-            totalAmt += temp->totalAmt;
-            fprintf(stream, "$%.2f\n", totalAmt);
-        }
-
-
-        if(temp->next == NULL)
-            flag = VERIFIED; //We're at the end of list, using temp so we dont use head of list location
-        else
-            temp = temp->next; //move to next row
-    }
-
-    return;
-}//END printRows
-
-void printTotal(FILE* stream)
-{
-    struct row* temp = root;
-
-    while(temp != NULL)
-    {
-        fprintf(stream, temp->dName); fprintf(stream, ",");//Write Display Name & Comma
-        fprintf(stream, temp->mobileAmt); fprintf(stream, ",");//Write Mobile Amt & Comma
-        fprintf(stream, temp->discountAmt);fprintf(stream, ",");//Write Discount Amt & Comma
-        fprintf(stream, temp->feeAmt); fprintf(stream, ",");//Write Fee Amt & Comma
-        fprintf(stream, temp->netAmt); fprintf(stream, ",");//Write Net Amt & Comma
-
-        system("pause");
-        temp->totalAmt =- (strToFloat(temp->feeAmt,"$0.00"));
-        system("pause");
-
-        fprintf(stream, "$%.2f\n", temp->totalAmt);
-
-        temp = temp->next;
-    }
-
-    fprintf(stream, "\n");
-    fprintf(stream, "\n");
-    fprintf(stream, "Totals:");
-    return;
-
-}//END printTotal
-
-void freeList(struct row* node)
-{
-    struct row* temp;
-
-    while(node->next != NULL)//while there are nodes remaining to free
-    {
-        temp = node->next;//move temp to next node over
-        free(node);//free curr node
-        node = temp;//set root to next node
-    }
-
-    free(node);
-    free(temp);
-    return;
-}
-
-float strToFloat(char mobileAmt[MAX_STRING_LEN],char discountAmt[MAX_STRING_LEN])
-{
-    float net = 0.00;
-    float amt;
-    int i, j;
-    int length = strlen(mobileAmt);
-
-    /*
-        mobileAmt in form:   '$0.00'
-        discountAmt in form: '$0.00'
-    */
-
-    //Determine where the '.' is:
-    for(i = 0; i < length; i++)//loop through string
-    {
-        if(mobileAmt[i] == '.')//once we find our decimal marker
-        {
-            //Get & Add Hundredths Place
-            amt = mobileAmt[i+2] - '0';
-            net += 0.01*amt;
-
-            //Get & Add Tenths Place
-            amt = mobileAmt[i+1] - '0';
-            net += 0.1*amt;
-
-            //Get & Add Ones Place
-            amt = mobileAmt[i-1] - '0';
-            net += 1.0*amt;
-
-            if(i == 3)
-            {
-                //Get & Add Tens Place IF IT EXISTS
-                amt = mobileAmt[i-2] - '0';
-                net += 10.0*amt;
-            }
-
-            if(i == 4)
-            {
-                //Get & Add Hundreds Place IF IT EXISTS
-                amt = mobileAmt[i-3] - '0';
-                net += 100.0*amt;
-            }
-        }
-    }
-
-    //Repeat same process for discountAmt
-    length = strlen(discountAmt);
-
-    //Determine where the '.' is:
-    for(i = 0; i < length; i++)//loop through string
-    {
-        if(discountAmt[i] == '.')//once we find our decimal marker
-        {
-            //Get & Sub Hundredths Place
-            amt = discountAmt[i+2] - '0';
-            net -= 0.01*amt;
-
-            //Get & Sub Tenths Place
-            amt = discountAmt[i+1] - '0';
-            net -= 0.1*amt;
-
-            //Get & Sub Ones Place
-            amt = discountAmt[i-1] - '0';
-            net -= 1.0*amt;
-
-            if(i == 3)
-            {
-                //Get & Sub Tens Place IF IT EXISTS
-                amt = discountAmt[i-2] - '0';
-                net -= 10.0*amt;
-            }
-
-            if(i == 4)
-            {
-                //Get & Sub Hundreds Place IF IT EXISTS
-                amt = discountAmt[i-3] - '0';
-                net -= 100.0*amt;
-            }
-        }
-    }
-
-    return net;
-}//END strToInt
-
-char* removeNewLine(char netAmt[MAX_STRING_LEN])
-{
-    char* pos;
-
-    if((pos=strchr(netAmt, '\n')) != NULL)//Case 1: Has NewLineChar, must remove it
-    {
-         *pos = '\0';
-         return netAmt;
-    }
-    else//Case 2: Has no newline char
-    {
-        return netAmt;
-    }
-}//END removeNewLine
-
-char* concat(const char *s1, const char *s2)
-{
-    char *result = malloc(strlen(s1)+strlen(s2)+1);//+1 for the zero-terminator
-
-    strcpy(result, s1);
-    strcat(result, s2);
-
-    return result;
-}
-
-bool isLetter(char ch)
-{
-    /*
-       ASCII
-       65(A) to 90(Z)
-       97(a) to 122(z)
-       (difference of 32)
-    */
-        if((64 < ch) && (ch < 91))//lowercase
-        {
-            return true;
-        }
-        else if((96 < ch) && (ch < 123))//uppercase
-        {
-            return true;
-        }
-        else//not a char
-        {
-            return false;
-        }
-}//END isLetter
-
-bool isNextMatch(char currName[MAX_STRING_LEN],char nextName[MAX_STRING_LEN])
-{
-    int i;
-
-    int currLength = strlen(currName);//get length of current node's dName
-    int currSeperatorLoc;
-
-    int nextLength = strlen(nextName);//get length of next node's dName
-    int nextSeperatorLoc;
-
-    /*
-    find the '-' seperator. Characters before the '-' will be
-    compared to see if they are from the same account so
-    they can be grouped together. used for totaling amts for a single account
-    with multiple machines
-    */
-    for(i = 0; i<currLength ;i++)
-    {
-        if(currName[i] == '-')
-        {
-            currSeperatorLoc = i;
-        }
-    }
-
-    for(i = 0; i<nextLength ;i++)
-    {
-        if(nextName[i] == '-')
-        {
-            nextSeperatorLoc = i;
-        }
-    }
-
-    if(currSeperatorLoc != nextSeperatorLoc)//'-' not in same position in string, automatically reject
-    {
-        return false;
-    }
-
-    for(i = 0; i<currSeperatorLoc; i++)
-    {
-        if(currName[i] != nextName[i]) //if something in the string differs before the seperator, reject
-            return false;
-    }
-
-    return true;//all chars in string matched before seperator
-}//END isNextMatch()
-
-bool moneyExists(struct row* node)
-{
-    //printf("\nMade in to moneyExists and mobileAmt is: (%s)\n", node->mobileAmt); system("pause");
-    if(moneyCheck(node->mobileAmt))
-    {
-        //printf("\nCheck #1\n");
-        return true;
-    }
-    else if(moneyCheck(node->discountAmt))
-    {
-         //printf("\nCheck #2\n");
-         return true;
-    }
-    else if(moneyCheck(node->feeAmt))
-    {
-        //printf("\nCheck #3\n");
-        return true;
-    }
-    else
-    {
-        //printf("\nCheck#4\n");
-        return false;
-    }
-
-}
-
-bool moneyCheck(char amt[MAX_STRING_LEN])
-{
-    //system("pause");
-    //printf("\nCompare Started");
-    int x = strcmp("$0.00", amt);
-    int y = strcmp("$0.00 ", amt);
-    int z = strcmp(" $0.00", amt);
-    //printf("\nCompare Finished\n");
-
-    if(x == 0)
-        return false;
-    else if(y == 0)
-        return false;
-    else if(z == 0)
-        return false;
-    else
-        return true;
-}
-
-void showHead()
-{
-    printf("\nHead Node: \n");
-    printf("\nDisplay Name: (%s)", head->dName);
-    printf("\nMobile Amt: (%s)", head->mobileAmt);
-    printf("\nDiscount Amt: (%s)", head->discountAmt);
-    printf("\nFee Amt: (%s)", head->feeAmt);
-    printf("\nNet Amt: (%s)", head->netAmt);
-
-    printf("\nHead Node: \n");
-    printf("\nDisplay Name: (%s)", head->next->dName);
-    printf("\nMobile Amt: (%s)", head->next->mobileAmt);
-    printf("\nDiscount Amt: (%s)", head->next->discountAmt);
-    printf("\nFee Amt: (%s)", head->next->feeAmt);
-    printf("\nNet Amt: (%s)", head->next->netAmt);
-    system("pause");
-    return;
-}//END showHead
-
-void showNode(struct row* node)
-{
-    printf("\nNode Information: \n");
-    printf("\nDisplay Name: (%s)", node->dName);
-    printf("\nMobile Amt: (%s)", node->mobileAmt);
-    printf("\nDiscount Amt: (%s)", node->discountAmt);
-    printf("\nFee Amt: (%s)", node->feeAmt);
-    printf("\nNet Amt: (%s)\n", node->netAmt);
-    return;
-}//END showNode
-
-void showList()
-{
-    struct row* temp = head;
-    int count = 1;
-
-    while(temp->next != NULL)
-    {
-        printf("\n--------------------------------------");
-        printf("\nNode (%d)", count++);
-        printf("\nDisplay Name:  (%s)",temp->dName);
-        printf("\nMobile Amt:    (%s)",temp->mobileAmt);
-        printf("\nFee Amt:       (%s)",temp->feeAmt);
-        printf("\nDiscount Amt:  (%s)",temp->discountAmt);
-        printf("\nNet Amt:       (%s",temp->netAmt);
-
-        if((count % 20) == 0)
-            system("pause");
-
-        temp = temp->next;
-    }
-
-
-    return;
-}//END showList
-
-void countPause(int n)
-{
-    if(n > 240)
-    {
-        system("pause");
-    }
-    return;
-}
+/*
+    This program was designed by Alex Arwin
+    a current employee of Gator Vending
+    for use solely by Gator Vending, Inc.
+    It's sole purpose is designed to minimize the
+    grunt work it currently takes to process a
+    weekly PayRange Report.
+
+    Current Method:
+        Download File
+        Manually extract useful information
+        Manually adjust columns/rows to readily show information
+        Manually total columns with same Display Names
+        Enter into our accounting software
+
+    Goal Method:
+        Download File
+        Run .exe
+        Enter into our accounting software
+
+    Assumptions Made:
+        The Downloaded PayRange File does not significantly change format styles over time
+        The Number of Rows in the PayRange File is not extremely large(excess of 1000)
+            --This is mentioned because the methods used to extract, parse, and sort
+              the data is not exactly efficient and I am okay with this as the data set
+              is never expected to grow much larger than 500 lines.
+        No Line in the PayRange File is longer than 200 characters
+        No Display Name is longer than 80 characters.
+            --These numbers were chosen after carefully examining the file being parsed in
+              its original form. They allow some minor expansion to occur without causing
+              a parsing problem.
+
+    Note(s):
+        The Data Structure being implemented is Linked Lists
+        The Sorting Algorithm is Bubble Sort
+        The <zstring.h> is a custom library created with a sole
+            purpose of fixing many of the pitfalls the more
+            common <string.h> standard library experiences. More specifically
+            I make use of it to avoid skipping tokens with no values
+            (like strtok()) currently does. This allows me to account
+            for columns that are blank/empty.
+
+*/
+//Header & Library File(s)
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <limits.h>
+#include <ctype.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+#else
+#define popen _popen
+#define pclose _pclose
+#endif
+#include "zstring.h"
+
+//Constant(s)
+#define NOTVERIFIED -1
+#define VERIFIED 1
+#define MAX_STRING_LEN 80
+#define MAX_CSV_LEN 200 //line buffers start this big, see appendLine() for longer lines
+#define FIELD_INLINE 16 //amount text kept in the row itself, longer spills to the field arena
+#define FIELD_PAGE 65536 //bytes per field arena page
+#define MAX_GROUP_SETS 16
+#define GROUP_BUCKETS 1024
+#define ACCOUNT_BUCKETS 1024
+#define SHARED_MAP_SLOTS 65536 //accounts the shared map can hold (power of 2)
+#define NAME_SLOTS (1 << 21) //hash slots the name pool starts with (power of 2), see growPool()
+#define DICT_SLOTS (1 << 16) //hash slots each column dictionary starts with (power of 2)
+#define NAME_PAGE 4096 //strings per page of a pool
+#define MAX_NAME_PAGES (1 << 16) //so a pool holds at most NAME_PAGE * MAX_NAME_PAGES strings
+#define NAME_BUSY 0xFFFFFFFFu //name slot claimed but not filled in yet
+#define RING_SIZE 64 //batches in flight between two pipeline stages (power of 2)
+#define RING_SPINS 64 //sched_yield()s a stage tries on a full or empty ring before it sleeps
+#define RING_INIT { .lock = PTHREAD_MUTEX_INITIALIZER, .changed = PTHREAD_COND_INITIALIZER }
+#define BATCH_LINES 256 //lines per batch handed from the reader to the parser
+#define BATCH_ROWS 256 //rows per batch handed from the parser to the aggregator
+#define CHUNK_BYTES (4 * 1024 * 1024) //big files are split into parse tasks of about this size
+
+//Row Index, see --index
+#define INDEX_MAGIC "PRIDX1" //first bytes of a .csv.idx
+#define INDEX_SAMPLE 65536 //bytes hashed at each end of the CSV to tell if it changed
+#define INDEX_BLOCK (1024 * 1024) //read size for the scan that builds an index
+
+//Checkpoints, see checkpoint()
+#define CHECKPOINT_MAGIC "PRCKPT1" //first line of a .ckpt starts with it
+
+//Fee-only section of _parsed.csv, see printTotal()
+#define FEE_SECTION "Fee Only:"
+#define FEE_TOTALS "Fee Only Totals:"
+
+//Reconciliation, see --reconcile
+#define RECONCILE_BATCH 256 //rows checked together, see reconcileBatch()
+
+#define TASK_FILE 1
+#define TASK_CHUNK 2
+
+//Input Compression, see openInput()
+#define CODEC_NONE 0 //plain .csv
+#define CODEC_GZIP 1 //.csv.gz
+#define CODEC_ZSTD 2 //.csv.zst
+
+/*
+Columns a rollup can be grouped on. A grouping set is a bitmask of these,
+so several levels (machine, account, city, state, grand total) can all be
+totaled in the same pass over the rows.
+*/
+#define GROUP_DNAME   0x01
+#define GROUP_ACCOUNT 0x02
+#define GROUP_CITY    0x04
+#define GROUP_STATE   0x08
+#define GROUP_ZIP     0x10
+#define GROUP_TAGS    0x20
+#define GROUP_MACHINE 0x40
+#define GROUP_COLUMNS 7 //one code per GROUP_* column in a group key
+
+//Column Dictionaries, see internString()
+#define DICT_CITY    0
+#define DICT_STATE   1
+#define DICT_ZIP     2
+#define DICT_TAGS    3
+#define DICT_MACHINE 4
+#define DICT_COLUMNS 5
+
+/*
+Projection plan, compiled by parseHeaders() into the columnMap: what
+parseLine() does with each column's token.
+*/
+#define MAX_COLUMNS 64 //columns past this are always skipped
+#define ACT_SKIP  0 //not wanted, don't even cut it out of the line
+#define ACT_NAME  1 //intern as the Display Name
+#define ACT_MONEY 2 //copy into amount string slot (AMOUNT_*)
+#define ACT_DICT  3 //intern into dictionaries[slot]
+#define AMOUNT_MOBILE   0
+#define AMOUNT_DISCOUNT 1
+#define AMOUNT_FEE      2
+#define AMOUNT_NET      3
+
+/*
+Header names we know, matched after normalizeHeader() (lower case, spaces
+collapsed, no quotes, CR or BOM). Each one says which columnMap field it
+fills; HDR_SKIP ones are PayRange columns we don't keep, so they aren't
+reported as unknown. Add a label here when PayRange renames one.
+*/
+#define HDR_SKIP    -1
+#define HDR_NAME    0
+#define HDR_MOBILE  1
+#define HDR_DISC    2
+#define HDR_FEE     3
+#define HDR_NET     4
+#define HDR_CITY    5
+#define HDR_STATE   6
+#define HDR_ZIP     7
+#define HDR_TAGS    8
+#define HDR_MACHINE 9
+#define HEADER_ALIASES(X) \
+    X("display name",   HDR_NAME) \
+    X("name",           HDR_NAME) \
+    X("account name",   HDR_NAME) \
+    X("mobile",         HDR_MOBILE) \
+    X("mobile ($)",     HDR_MOBILE) \
+    X("mobile amount",  HDR_MOBILE) \
+    X("mobile sales",   HDR_MOBILE) \
+    X("discounts",      HDR_DISC) \
+    X("discount",       HDR_DISC) \
+    X("discounts ($)",  HDR_DISC) \
+    X("fee",            HDR_FEE) \
+    X("fees",           HDR_FEE) \
+    X("fee ($)",        HDR_FEE) \
+    X("payrange fee",   HDR_FEE) \
+    X("net",            HDR_NET) \
+    X("net ($)",        HDR_NET) \
+    X("net amount",     HDR_NET) \
+    X("city",           HDR_CITY) \
+    X("state",          HDR_STATE) \
+    X("st",             HDR_STATE) \
+    X("zip code",       HDR_ZIP) \
+    X("zip",            HDR_ZIP) \
+    X("zipcode",        HDR_ZIP) \
+    X("postal code",    HDR_ZIP) \
+    X("tags",           HDR_TAGS) \
+    X("tag",            HDR_TAGS) \
+    X("machine id",     HDR_MACHINE) \
+    X("machine",        HDR_MACHINE) \
+    X("machine #",      HDR_MACHINE) \
+    X("device id",      HDR_SKIP) \
+    X("location",       HDR_SKIP) \
+    X("mobile (#)",     HDR_SKIP) \
+    X("mobile (%)",     HDR_SKIP) \
+    X("cash",           HDR_SKIP) \
+    X("card",           HDR_SKIP) \
+    X("total",          HDR_SKIP) \
+    X("loyalty",        HDR_SKIP) \
+    X("promotions (!)", HDR_SKIP)
+#define HEADER_SLOTS 256 //perfect hash table size, power of 2
+#define SNIFF_LINES 256 //lines after the headers sniffDialect() looks at
+#define MAX_HEADER_LEN 64
+
+/*
+The layout PayRange has exported for a long time. X(col, header, action,
+row field, slot) for every column; parseHeaders() checks the plan against
+it and the parseKnownLine() kernels are generated from it, so when it matches every
+column's handling is fixed at compile time. Column 1 is on the short
+first line of a row, parsing starts at 2 (the end of Location).
+*/
+#define PAYRANGE_COLUMNS 19
+#define PAYRANGE_LAYOUT(X) \
+    X(1,  "Device ID",      SKIP,  -,           0) \
+    X(2,  "Location",       SKIP,  -,           0) \
+    X(3,  "City",           DICT,  city,        DICT_CITY) \
+    X(4,  "State",          DICT,  state,       DICT_STATE) \
+    X(5,  "Zip Code",       DICT,  zipCode,     DICT_ZIP) \
+    X(6,  "Display Name",   NAME,  nameId,      0) \
+    X(7,  "Machine ID",     DICT,  machineId,   DICT_MACHINE) \
+    X(8,  "Tags",           DICT,  tags,        DICT_TAGS) \
+    X(9,  "Mobile (#)",     SKIP,  -,           0) \
+    X(10, "Mobile (%)",     SKIP,  -,           0) \
+    X(11, "Mobile",         MONEY, mobileAmt,   AMOUNT_MOBILE) \
+    X(12, "Cash",           SKIP,  -,           0) \
+    X(13, "Card",           SKIP,  -,           0) \
+    X(14, "Total",          SKIP,  -,           0) \
+    X(15, "Fee",            MONEY, feeAmt,      AMOUNT_FEE) \
+    X(16, "Discounts",      MONEY, discountAmt, AMOUNT_DISCOUNT) \
+    X(17, "Loyalty",        SKIP,  -,           0) \
+    X(18, "Promotions (!)", SKIP,  -,           0) \
+    X(19, "Net",            MONEY, netAmt,      AMOUNT_NET)
+
+//Top-K Report Metrics, see --by
+#define TOP_MOBILE    0
+#define TOP_DISCOUNTS 1
+#define TOP_FEE       2
+#define TOP_NET       3
+#define TOP_TOTAL     4
+#define TOP_SHARE     5 //Discounts / Mobile
+
+//Output Formats, see --format
+#define FORMAT_CSV    0
+#define FORMAT_NDJSON 1 //one JSON object per line
+
+//Arrow Output, see --arrow
+#define ARROW_BATCH_ROWS 65536 //rows per record batch
+#define ARROW_COLUMNS 7 //Display Name, Account, Mobile, Discounts, Fee, Net, Total
+
+//Struct(s)
+typedef struct field
+{
+    char* spill; //text in the field arena when it didn't fit, NULL otherwise
+    char text[FIELD_INLINE]; //the text when it fits, which is nearly always
+} field;
+
+typedef struct lineBuffer
+{
+    char* text; //starts out as the caller's own array, moves to the heap if a line outgrows it
+    size_t size;
+    size_t used; //bytes taken by the lines read so far, '\0's included
+    bool onHeap; //text was grown onto the heap, freeLine() gives it back
+} lineBuffer;
+
+typedef struct row
+{
+    unsigned nameId; //Name of PayRange Location, interned (see internName)
+    struct field mobileAmt; //Raw Amount Before Reductions
+    struct field feeAmt; //Fee Amt (%-baseD)
+    struct field discountAmt;//Amt of Discounts Given
+    struct field netAmt; //Net Amt after Discount & Fee
+    unsigned city; //City the Machine is in, code in dictionaries[DICT_CITY]
+    unsigned state; //State the Machine is in, code in dictionaries[DICT_STATE]
+    unsigned zipCode; //Zip Code the Machine is in, code in dictionaries[DICT_ZIP]
+    unsigned tags; //PayRange Tags (promo, etc.), code in dictionaries[DICT_TAGS]
+    unsigned machineId; //Our Machine ID (N/A if not assigned), code in dictionaries[DICT_MACHINE]
+    float totalAmt; //Total Amt used to total accounts (Mobile minus Discounts)
+    long long mobileCents; //Amounts above in cents, filled in by convertRow() so sums are exact
+    long long discountCents;
+    long long feeCents;
+    long long netCents;
+    long long totalCents; //Mobile minus Discounts, see rowTotal()
+
+    struct row* next; //pointer to next item in LL
+} row;
+
+/*
+Every Display Name (and every account part of one) is stored once in the
+name pool and rows only carry its 32-bit ID. Whatever sorting & grouping
+need from the name is worked out once, when it is interned. The column
+dictionaries reuse the same entries, they just have no account part.
+*/
+typedef struct internedName
+{
+    char* text;
+    unsigned hash; //hashString() of text
+    int prefixLength; //length of the account part, see accountKeyLength()
+    unsigned accountId; //ID of the account part, interned too (itself if there is no '-')
+    unsigned long long sortKey; //first 8 bytes of the collation key packed big-endian
+    unsigned char* collateKey; //--collate human: binary key, memcmp orders names (NULL otherwise)
+    int collateLength;
+} internedName;
+
+typedef struct stringPool
+{
+    const char* what; //what the pool holds, for the error when it fills up
+    bool accounts; //also intern the account part of every string (the name pool)
+    unsigned slotCount; //power of 2, doubled by growPool() once the pool is half full
+    atomic_uint* slots; //0 = free, NAME_BUSY = being filled, otherwise ID + 1
+    pthread_rwlock_t resize; //interning holds it shared, growPool() holds it alone
+    _Atomic(struct internedName*) pages[MAX_NAME_PAGES];
+    atomic_uint count;
+} stringPool;
+
+typedef struct accountTotal
+{
+    unsigned accountId; //Display Name up to the '-', see isNextMatch()
+    int rows;
+    long long mobileCents;
+    long long discountCents;
+    long long feeCents;
+    long long netCents;
+    long long totalCents;
+
+    struct accountTotal* next; //next account in the same hash bucket
+} accountTotal;
+
+/*
+Per-Account totals. Each parse worker fills its own table and the
+tables are added together once the file is done. Everything is whole
+cents, so the result is the same no matter how many threads or chunks
+the file was split into.
+*/
+typedef struct accountTable
+{
+    struct accountTotal* buckets[ACCOUNT_BUCKETS];
+    int count;
+} accountTable;
+
+/*
+Lock-free account totals for when several producers add to the same
+file at once. Open addressing: a slot is claimed by swapping its interned
+account ID in from 0 and never changes owner after that, the counters
+are atomic adds. Readers can copy it at any time without stopping the
+writers.
+*/
+typedef struct sharedSlot
+{
+    atomic_uint account; //account ID + 1, 0 while the slot is free
+    atomic_int rows;
+    atomic_llong mobileCents;
+    atomic_llong discountCents;
+    atomic_llong feeCents;
+    atomic_llong netCents;
+    atomic_llong totalCents;
+} sharedSlot;
+
+typedef struct sharedMap
+{
+    struct sharedSlot* slots; //NULL when the map isn't in use
+    atomic_int count; //slots claimed
+} sharedMap;
+
+typedef struct columnMap
+{
+    int dName; //column # of each header we keep, 0 if the file doesn't have it
+    int mobileAmt;
+    int discountAmt;
+    int feeAmt;
+    int netAmt;
+    int city;
+    int state;
+    int zipCode;
+    int tags;
+    int machineId;
+    int totalColumns; //total amount of columns seen in the file
+
+    unsigned char action[MAX_COLUMNS + 1]; //ACT_* for each column #, [0] stays ACT_SKIP for the ones past MAX_COLUMNS
+    unsigned char slot[MAX_COLUMNS + 1]; //AMOUNT_* or DICT_* the action fills
+    int lastColumn; //last column with an action, the rest of a row is never looked at
+    bool knownLayout; //plan is exactly PAYRANGE_LAYOUT's, a parseKnownLine() kernel can be used
+
+    //Dialect of the file, see sniffDialect()
+    char delim; //',', ';' (Excel outside the US) or '\t'
+    bool crlf; //lines end in "\r\n"
+    bool bom; //starts with a UTF-8 BOM
+    bool quoted; //fields past Location are quoted, delimiters can show up inside them
+    bool (*knownParser)(char*, struct row*, int*); //kernel for this dialect, NULL if there isn't one
+    int unknownColumns; //headers not in HEADER_ALIASES
+    char firstUnknown[MAX_HEADER_LEN]; //the first of them, for the stats
+} columnMap;
+
+typedef struct headerSlot
+{
+    unsigned long long hash; //full hash of the alias, 0 if the slot is empty
+    int header; //HDR_*
+} headerSlot;
+
+typedef struct group
+{
+    int set; //Index of the grouping set this total belongs to
+    unsigned codes[GROUP_COLUMNS]; //Column codes of this group, what rows are matched on
+    char* key; //Column values of this group, joined by " | ", for printing (sized by groupKeyText())
+    int rows; //Number of rows that fell into this group
+    long long mobileCents; //Totals are kept in cents so they add up exactly
+    long long discountCents;
+    long long feeCents;
+    long long netCents;
+    long long totalCents; //same as row->totalCents
+
+    struct group* next; //next group in the same hash bucket
+} group;
+
+/*
+Group-By totals, laid out like the account totals. Each parse worker
+fills its own table and they are added together once the file is done.
+*/
+typedef struct groupTable
+{
+    struct group* buckets[GROUP_BUCKETS];
+    int count;
+} groupTable;
+
+/*
+Rows waiting to go out as one Arrow record batch. Names are kept the way
+Arrow lays out a utf8 column: all the bytes back to back plus count + 1
+offsets, so they are written out as is.
+*/
+typedef struct arrowBatch
+{
+    int count;
+    long long cents[5][ARROW_BATCH_ROWS]; //Mobile, Discounts, Fee, Net, Total
+    int offsets[2][ARROW_BATCH_ROWS + 1]; //Display Name, Account
+    char* text[2];
+    int capacity[2];
+} arrowBatch;
+
+typedef struct fbBuilder
+{
+    unsigned char* data; //flatbuffer being built front to back, see fbTable()
+    int size;
+    int capacity;
+} fbBuilder;
+
+typedef struct topEntry
+{
+    unsigned nameId; //Display Name, or the account part of it for --of account
+    int rows;
+    long long mobileCents;
+    long long discountCents;
+    long long feeCents;
+    long long netCents;
+    long long totalCents;
+} topEntry;
+
+/*
+Single-Producer/Single-Consumer ring buffer connecting two pipeline
+stages. Only the producer moves tail and only the consumer moves head,
+so no locks are needed. When it is full the producer waits, which keeps
+the memory used by the pipeline flat no matter how big the file is.
+*/
+typedef struct ring
+{
+    void* slots[RING_SIZE]; //batches waiting for the next stage, NULL marks the end
+    atomic_size_t head; //next slot to be read
+    atomic_size_t tail; //next slot to be filled
+    atomic_int sleepers; //stages asleep on changed, the other side only signals when there are some
+    pthread_mutex_t lock;
+    pthread_cond_t changed; //a slot was filled or given back
+} ring;
+
+typedef struct lineBatch
+{
+    int count;
+    struct lineBuffer text; //the lines one after another
+    size_t starts[BATCH_LINES]; //where each line starts in text, it can move as it grows
+} lineBatch;
+
+typedef struct rowBatch
+{
+    int count; //rows with money kept in this batch
+    int rowsRead; //rows parsed for this batch, kept or not (for the stats)
+    struct row* rows[BATCH_ROWS];
+} rowBatch;
+
+typedef struct mismatch
+{
+    unsigned nameId; //Display Name of the row that is off
+    long long mobileCents;
+    long long discountCents;
+    long long feeCents;
+    long long netCents;
+} mismatch;
+
+/*
+Rows waiting for the --reconcile check. The cents are copied out column
+by column so reconcileBatch() can run down plain arrays; rows themselves
+may be written & freed before the batch fills.
+*/
+typedef struct centBatch
+{
+    long long mobile[RECONCILE_BATCH];
+    long long discount[RECONCILE_BATCH];
+    long long fee[RECONCILE_BATCH];
+    long long net[RECONCILE_BATCH];
+    unsigned nameId[RECONCILE_BATCH];
+    int count; //rows waiting in the arrays
+    long long checked; //rows checked so far
+    struct mismatch* found; //rows that were off, in the order they were read
+    int foundCount;
+    int foundSize;
+} centBatch;
+
+/*
+Sorted runs spilled to disk under --mem-budget, in the order their rows
+were read. mergeRuns() breaks ties by run, so keeping that order keeps
+equal names in file order.
+*/
+typedef struct runList
+{
+    FILE** files; //temp files, removed automatically once closed
+    int count;
+    int capacity;
+} runList;
+
+/*
+One input file being run by the scheduler. Its file task reads the
+headers and splits the file into chunk tasks, any worker can pick those
+up. The worker that finishes the last chunk merges & writes the file.
+*/
+typedef struct rowIndex
+{
+    long long* offsets; //byte offset where each record starts, after the headers
+    int count;
+} rowIndex;
+
+typedef struct job
+{
+    char filename[MAX_STRING_LEN];
+    struct columnMap columns; //this file's own column positions
+    long dataStart; //byte offset of the first line after the headers
+    long fileSize;
+    int codec; //compressed files can't be seeked, they are one chunk
+    struct rowIndex index; //record offsets from the .csv.idx, count 0 without --index
+    int rowFirst; //records this job parses, [rowFirst, rowLast), only with an index
+    int rowLast;
+    int chunkCount;
+    atomic_int chunksLeft; //chunk tasks not finished yet
+    struct row** chunkHeads; //sorted rows of each chunk, in file order
+    struct row** chunkFees; //fee-only rows of each chunk, in file order
+    struct runList* chunkRuns; //--mem-budget: runs each chunk spilled, finishJob() merges them
+    atomic_llong held; //this file's share of heldRows
+    int* chunkRead; //rows read by each chunk (for the stats)
+    int* chunkKept; //rows kept by each chunk
+    struct accountTable* partials; //account totals, one table per worker
+    struct groupTable* rollups; //--group-by totals, one table per worker
+    struct sharedMap shared; //--shared-totals: one map every worker adds into instead
+    struct centBatch* chunkChecks; //--reconcile: each chunk's own batch, NULL without it
+} job;
+
+typedef struct task
+{
+    int type; //TASK_FILE or TASK_CHUNK
+    struct job* job;
+    int chunk; //which chunk of the job, TASK_CHUNK only
+} task;
+
+/*
+Each worker owns a deque of tasks. It pushes & pops its own tasks at
+the bottom and, when it runs dry, steals from the top of someone
+else's, so idle cores end up helping with the biggest file.
+*/
+typedef struct worker
+{
+    pthread_t thread;
+    int id;
+    pthread_mutex_t lock;
+    struct task** tasks; //circular buffer
+    int capacity;
+    int top; //steal end
+    int bottom; //owner end
+} worker;
+
+typedef struct mergeInput
+{
+    FILE* stream; //already sorted file being merged
+    struct row current; //row this input is sitting on, next to be merged
+    bool (*read)(FILE*, struct row*); //how to get the next row: readParsedRow, readRunRow or readHeadRow
+} mergeInput;
+
+//Global Variable(s)
+char filename[MAX_STRING_LEN];
+const char comma[2] = ",";
+const size_t amountFields[4] = { offsetof(struct row, mobileAmt), offsetof(struct row, discountAmt),
+                                 offsetof(struct row, feeAmt), offsetof(struct row, netAmt) }; //indexed by AMOUNT_*
+const size_t codeFields[DICT_COLUMNS] = { offsetof(struct row, city), offsetof(struct row, state), offsetof(struct row, zipCode),
+                                          offsetof(struct row, tags), offsetof(struct row, machineId) }; //indexed by DICT_*
+const char* inputExtensions[3] = { ".csv", ".csv.gz", ".csv.zst" }; //indexed by CODEC_*
+const char* decompressors[3] = { NULL, "gzip -dc", "zstd -dcq" };
+const char* outputExtensions[3] = { "", ".gz", ".zst" }; //added to every file we write, see --compress
+const char* compressors[3] = { NULL, "gzip -c", "zstd -q -T0 -c" }; //gzip is swapped for pigz when it's there
+const size_t headerFields[10] = { offsetof(struct columnMap, dName), offsetof(struct columnMap, mobileAmt),
+                                  offsetof(struct columnMap, discountAmt), offsetof(struct columnMap, feeAmt),
+                                  offsetof(struct columnMap, netAmt), offsetof(struct columnMap, city),
+                                  offsetof(struct columnMap, state), offsetof(struct columnMap, zipCode),
+                                  offsetof(struct columnMap, tags), offsetof(struct columnMap, machineId) }; //indexed by HDR_*
+
+/*
+For this program to work dynamically with PayRange
+we need to search the headers and assign what column the data
+we're looking for is in so we can skip extraneous data and only
+store the desired data
+*/
+struct columnMap columns;
+char* fieldPage = NULL; //field arena page being filled, pages are kept until exit like rows' names
+size_t fieldPageUsed = FIELD_PAGE;
+pthread_mutex_t fieldLock = PTHREAD_MUTEX_INITIALIZER; //spills are rare, a lock is plenty
+headerSlot headerTable[HEADER_SLOTS]; //HEADER_ALIASES by headerHash(), see initHeaderTable()
+unsigned long long headerSeed = 0; //seed that gives every alias its own slot
+int totalNodes = 0;
+
+struct row* root = NULL;//Root of the Linked List. No Mobile,Discount, but Fee Exists, Keep these seperate.
+struct row* rootTail = NULL;//new fee-only rows are linked after it, see keepFeeRow()
+int feeOnlyRows = 0; //for the stats
+struct row* feeOffered = NULL; //last fee-only row handed to topRow(), see topFeeRows()
+struct row* head = NULL;//Head of the Linked List
+struct row* tail = NULL;//Tail of the Linked List, new nodes are linked after it
+struct accountTable accounts;//Account totals for the file being written
+
+//String Pools (see internString)
+struct stringPool names; //Display Names & their account parts
+struct stringPool dictionaries[DICT_COLUMNS]; //City, State, Zip Code, Tags, Machine ID
+
+/*
+Collation. --collate human orders Display Names the way people read
+them: case & accents don't matter and digit runs compare as numbers, so
+"Machine 2" comes before "Machine 10". Each distinct name gets a binary
+key once, when it is interned, so sorting only ever memcmp's keys.
+*/
+bool humanOrder = false;
+
+/*
+Group-By state. Each grouping set is a mask of GROUP_* columns, every kept
+row is added to all of them as it is parsed, so extra breakdowns cost
+a hash lookup per row instead of another parse & sort.
+*/
+unsigned groupSets[MAX_GROUP_SETS];
+int groupSetCount = 0;
+struct groupTable rollups; //Group-By totals for the file being written
+
+char* mergeOutput = NULL; //--merge: name of the period report to build from sorted outputs
+int outputCodec = CODEC_NONE; //--compress, every file we write goes through this compressor
+int exitStatus = 0; //main's return, 1 once a file couldn't be read or written whole
+
+/*
+Arrow output. --arrow also writes <file>_parsed.arrow, an Arrow IPC stream
+(schema, record batches, end marker) with the names as utf8 and every
+amount as int64 cents, so dataframe tools can map it without parsing.
+It is never compressed, that would defeat the point.
+*/
+bool arrowOutput = false;
+FILE* arrowOut = NULL;
+struct arrowBatch* arrowRows = NULL;
+
+/*
+--format ndjson writes <file>_parsed.ndjson instead of the csv: one object
+per machine row, one per account total (right after its last machine)
+and one for the file totals. Amounts are whole cents.
+*/
+int outputFormat = FORMAT_CSV;
+struct topEntry jsonPending; //account the rows written so far belong to
+
+/*
+Top-K report. --top K --by metric [--of account|machine] offers every
+machine (or account, once its last row is written) to a min-heap of at
+most K entries, so the worst of the best K is on top to be replaced.
+O(n log K) time and O(K) memory, no sort of everything needed.
+*/
+int topCount = 0; //--top, 0 = no report
+int topMetric = TOP_MOBILE; //--by
+bool topMachines = false; //--of machine, otherwise accounts
+struct topEntry* topHeap = NULL;
+int topSize = 0;
+struct topEntry topPending; //machine or account being added up as its rows go by
+
+/*
+External sort state. Once the kept rows of a file reach memoryBudget
+they are sorted and spilled to a temp file as a run, so huge dumps
+degrade to disk instead of running out of memory. On the scheduler half
+the budget is split between the running parse tasks, the other half is
+for the rows of finished ones, see runChunkTask().
+*/
+long long memoryBudget = 256LL * 1024 * 1024; //--mem-budget, in bytes (0 = no limit)
+struct runList runs; //sorted runs spilled to disk for the file being written
+int runRows = 0; //rows currently held in memory (head list)
+int keptRows = 0; //rows kept in total for this file
+
+/*
+Streaming mode. PayRange normally exports rows already in Display Name
+order, so each account can be totaled & written the moment its last row
+is parsed and then freed. If a row ever comes out of order we fall back
+to parsing again and sorting.
+*/
+bool streamInput = false; //--stream was asked for
+bool streaming = false; //the current parse is streaming
+FILE* streamOut = NULL; //_parsed.csv being written while we parse
+unsigned lastName = 0; //Display Name of the last row streamed, to check the order
+
+/*
+Pipeline mode. read -> parse -> aggregate (-> write when streaming) each
+run on their own thread, handing batches down through ring buffers.
+*/
+bool usePipeline = false; //--pipeline was asked for
+struct ring lineRing = RING_INIT; //reader -> parser
+struct ring rowRing = RING_INIT; //parser -> aggregator (main thread)
+struct ring writeRing = RING_INIT; //aggregator -> writer, whole accounts when streaming
+atomic_bool pipelineStop; //set when the aggregator gives up, stages drain & exit
+pthread_t writerThread;
+bool writerRunning = false;
+
+/*
+Work-stealing scheduler. Used for the files given on the command line
+unless --stream or --pipeline asked for the single file modes.
+*/
+int threadCount = 0; //--threads, 0 = one per core
+struct worker* workers = NULL;
+atomic_int pendingTasks; //tasks queued or running, workers quit once it hits 0
+atomic_llong heldRows; //rows finished chunk tasks of every file hold until finishJob(), see runChunkTask()
+pthread_mutex_t outputLock = PTHREAD_MUTEX_INITIALIZER; //one file at a time goes through the shared write globals
+pthread_mutex_t idleLock = PTHREAD_MUTEX_INITIALIZER; //idle workers sleep on workReady under this
+pthread_cond_t workReady = PTHREAD_COND_INITIALIZER; //signalled for each new task, broadcast when the last one ends
+unsigned taskPosts = 0; //bumped under idleLock by every pushTask, a task pushed before the wait isn't missed
+int lastChunkCount = 0; //for the stats
+bool useSharedTotals = false; //--shared-totals, workers add into one lock-free map
+bool lastShared = false; //for the stats
+bool useIndex = false; //--index, keep a .csv.idx of record offsets next to each file
+int firstRow = 0; //--rows first-last, only parse those records (1 based, 0 = no limit)
+int lastRow = 0;
+atomic_int indexesBuilt; //for the stats
+atomic_int indexesReused;
+
+/*
+Checkpoints: while streaming, every so often at the end of an account
+the input offset, how much of _parsed.csv is written and the totals so
+far are appended to <file>.ckpt, so --resume can carry on from there
+after a crash instead of from zero.
+*/
+bool useCheckpoints = true; //--no-checkpoint turns them off
+bool resumeRun = false; //--resume
+long long checkpointBytes = 64LL * 1024 * 1024; //input read between checkpoints, --checkpoint-mb
+long long inputRead = 0; //bytes of input read so far (decompressed)
+long long recordStart = 0; //where the row being parsed starts in the input
+long long lastCheckpoint = 0; //recordStart at the last checkpoint
+long long resumedFrom = -1; //input byte a --resume started at, for the stats
+int checkpointsWritten = 0; //for the stats
+FILE* checkpointLog = NULL;
+struct row* feeLogged = NULL; //last fee-only row written to the log, see logFeeRows()
+struct accountTotal carried; //accounts before the checkpoint we resumed from, added up
+
+bool reconcileRows = false; //--reconcile, check Net == Mobile - Fee - Discounts on every row
+struct centBatch checks; //--reconcile batch of the serial parse & the pipeline's parser stage
+long long reconcileChecked = 0; //for the stats
+int reconcileMismatched = 0;
+
+//Function Declaration(s)/Prototype(s)
+void run(void);
+bool verifyFileName(void);
+void parseHeaders(void);
+bool parsePayRangeFile(void);
+bool keepRow(struct row*);
+bool isFeeOnly(struct row*);
+long long rowTotal(long long, long long, long long);
+void keepFeeRow(struct row*);
+void sortFeeRows(void);
+void topFeeRows(unsigned, bool);
+bool parseLine(char*, struct row*, int*, const struct columnMap*);
+void compilePlan(struct columnMap*);
+bool knownComma(char*, struct row*, int*);
+bool knownCommaCRLF(char*, struct row*, int*);
+bool knownSemicolon(char*, struct row*, int*);
+bool knownSemicolonCRLF(char*, struct row*, int*);
+bool knownTab(char*, struct row*, int*);
+bool knownTabCRLF(char*, struct row*, int*);
+void sniffDialect(FILE*, const char*, struct columnMap*);
+char* nextQuoted(char**, char);
+char* skipQuoted(char*, char);
+bool isKnownLayout(const struct columnMap*);
+int normalizeHeader(const char*, char*);
+unsigned long long headerHash(const char*, int, unsigned long long);
+void initHeaderTable(void);
+int lookupHeader(const char*, int);
+void planColumn(struct columnMap*, int, int, int);
+bool parsePipeline(void);
+void* readerStage(void*);
+void* parserStage(void*);
+void* writerStage(void*);
+void runScheduler(char**, int);
+void* workerLoop(void*);
+void pushTask(struct worker*, struct task*);
+struct task* popTask(struct worker*);
+struct task* stealTask(struct worker*);
+void runFileTask(struct worker*, struct job*);
+void runChunkTask(struct worker*, struct job*, int);
+void finishJob(struct job*);
+void reconcileRow(struct centBatch*, struct row*);
+void reconcileBatch(struct centBatch*);
+void writeReconcileReport(const char*, struct centBatch*, int);
+bool canCheckpoint(void);
+void checkpoint(void);
+bool resumeCheckpoint(void);
+void endCheckpoints(void);
+bool inputIdentity(long long*, long long*);
+void logFeeRows(struct row*);
+struct row* readFeeLine(char*);
+void prepareIndex(struct job*);
+bool loadIndex(const char*, struct rowIndex*);
+bool buildIndex(const char*, long, struct rowIndex*);
+unsigned long long sampleHash(FILE*, long);
+long chunkOffset(struct job*, int);
+int coreCount(void);
+void ringInit(struct ring*);
+void ringPush(struct ring*, void*);
+void* ringPop(struct ring*);
+void ringWait(struct ring*, atomic_size_t*, size_t);
+void ringWake(struct ring*);
+void startStream(void);
+void flushAccount(void);
+void finishStream(void);
+void abandonStream(void);
+void alternativeSort(void);
+void writePayRangeFile(void);
+void printHeaders(FILE*);
+void printRows(FILE*, struct row*);
+void printTotal(FILE*);
+void freeList(struct row*);
+void groupRow(struct groupTable*, struct row*);
+void mergeGroups(struct groupTable*, struct groupTable*);
+void writeRollupFile(void);
+void freeGroups(struct groupTable*);
+void mergeParsedFiles(char**, int);
+FILE* openParsed(const char*);
+bool findFeeSection(FILE*);
+void writeMergedRows(FILE*, struct mergeInput*, int*, int, bool);
+void spillRun(void);
+bool spillList(struct runList*, struct row**);
+void addRun(struct runList*, FILE*);
+bool readHeadRow(FILE*, struct row*);
+void mergeRuns(FILE*);
+void printStats(const struct columnMap*);
+int inputCodec(const char*);
+FILE* openInput(const char*);
+bool closeInput(FILE*, const char*);
+bool closePipe(FILE*, const char*, const char*);
+int pathCodec(const char*);
+FILE* openPipe(const char*, const char*, const char*, const char*);
+FILE* openOutput(const char*);
+void closeOutput(FILE*);
+void topRow(unsigned, long long, long long, long long, long long);
+void topOffer(struct topEntry*);
+void topSiftDown(void);
+bool topWorse(struct topEntry*, struct topEntry*);
+void writeTopReport(const char*);
+void arrowRow(unsigned, long long, long long, long long, long long);
+const char* parsedSuffix(void);
+void printRowsJson(FILE*, struct row*);
+void jsonRow(FILE*, unsigned, long long, long long, long long, long long);
+void jsonAccount(FILE*);
+void jsonString(FILE*, const char*, int);
+void csvString(FILE*, const char*, int);
+void arrowFlush(void);
+void finishArrow(const char*);
+int arrowMessage(struct fbBuilder*, int, long long);
+void arrowSchema(void);
+void fbPut(struct fbBuilder*, const void*, int);
+void fbPad(struct fbBuilder*, int);
+void fbPatch(struct fbBuilder*, int, int);
+int fbTable(struct fbBuilder*, int, const int*, const long long*, int*);
+int fbString(struct fbBuilder*, const char*);
+int fbOffsets(struct fbBuilder*, int);
+
+//--Used to Debug During Development
+void showHead(void);
+void showNode(struct row*);
+void showList(void);
+void countPause(int);
+
+//--Helper Functions
+void nullify(struct row*);
+char* concat(const char*, const char*);
+void stripExtension(char*);
+void removeNoCashNodes(void);
+bool isLetter(char);
+bool isNextMatch(unsigned, unsigned);
+bool moneyExists(struct row*);
+bool moneyCheck(const char*);
+float strToFloat(char [MAX_STRING_LEN], char [MAX_STRING_LEN]);
+char* removeNewLine(char [MAX_STRING_LEN]);
+char* nextToken(char**, char);
+void convertRow(struct row*);
+int accountKeyLength(const char*);
+void initNames(void);
+void initPool(struct stringPool*, const char*, unsigned, bool);
+void growPool(struct stringPool*);
+unsigned internString(struct stringPool*, const char*);
+struct internedName* poolEntry(struct stringPool*, unsigned);
+unsigned internName(const char*);
+struct internedName* nameEntry(unsigned);
+const char* nameText(unsigned);
+const char* dictText(int, unsigned);
+int compareNames(unsigned, unsigned);
+int compareKeys(struct internedName*, struct internedName*);
+int collationKey(const char*, unsigned char*);
+void addToAccount(struct accountTable*, struct row*);
+void mergeAccounts(struct accountTable*, struct accountTable*);
+void freeAccounts(struct accountTable*);
+void sharedMapInit(struct sharedMap*);
+bool sharedMapAdd(struct sharedMap*, struct row*);
+void sharedMapSnapshot(struct sharedMap*, struct accountTable*);
+void sharedMapFree(struct sharedMap*);
+struct row* mergeLists(struct row*, struct row*);
+long long strToCents(const char*);
+void printCents(FILE*, long long);
+int accountLength(const char*);
+bool addGroupSet(const char*);
+void buildGroupKey(struct row*, unsigned, unsigned*);
+char* groupKeyText(unsigned, const unsigned*);
+void groupSetName(unsigned, char*);
+unsigned hashString(const char*);
+int compareGroups(const void*, const void*);
+bool readParsedRow(FILE*, struct row*);
+long appendLine(FILE*, struct lineBuffer*);
+char* readLine(FILE*, struct lineBuffer*);
+struct lineBatch* newLineBatch(void);
+void freeLine(struct lineBuffer*);
+void setField(struct field*, const char*);
+const char* fieldText(const struct field*);
+bool readRunRow(FILE*, struct row*);
+struct row* sortList(struct row*);
+bool mergeLess(struct mergeInput*, int, int);
+void heapPush(struct mergeInput*, int*, int*, int);
+int heapPop(struct mergeInput*, int*, int*);
+
+//Main
+int main(int argc, char *argv[])
+{
+    // NOTE ARGC = Argument Count && Argv = Argument Vector
+    //filename = *argv[0];
+
+    //Local Variable(s)
+    char** files = (char**)malloc(argc * sizeof(char*)); //file names given on the command line
+    int fileCount = 0;
+    int i;
+
+    initNames();
+
+    /*
+    strcpy(filename, "PayRange417to423");
+    run();
+    system("pause");
+
+    strcpy(filename, "PayRange424to430");
+    run();
+    system("pause");
+
+    strcpy(filename, "PayRange51to57");
+    run();
+    system("pause");
+
+    strcpy(filename, "PayRange58to514");
+    run();
+    */
+
+    for(i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--rollup") == 0)
+        {
+            //machine -> account -> city -> state -> grand total
+            addGroupSet("state,city,account,name");
+            addGroupSet("state,city,account");
+            addGroupSet("state,city");
+            addGroupSet("state");
+            addGroupSet("");
+        }
+        else if(strcmp(argv[i], "--merge") == 0 && (i + 1) < argc)
+        {
+            mergeOutput = argv[++i]; //rest of the files are sorted outputs to merge into this one
+        }
+        else if(strcmp(argv[i], "--pipeline") == 0)
+        {
+            usePipeline = true;
+        }
+        else if(strcmp(argv[i], "--threads") == 0 && (i + 1) < argc)
+        {
+            threadCount = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--shared-totals") == 0)
+        {
+            useSharedTotals = true;
+        }
+        else if(strcmp(argv[i], "--collate") == 0 && (i + 1) < argc)
+        {
+            i++;
+            if(strcmp(argv[i], "human") == 0)
+                humanOrder = true;
+            else if(strcmp(argv[i], "binary") != 0)
+            {
+                printf("Error: Unknown collation '%s'.\nCollations are: binary, human\n", argv[i]);
+                free(files);
+                return 1;
+            }
+        }
+        else if(strcmp(argv[i], "--top") == 0 && (i + 1) < argc)
+        {
+            topCount = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--by") == 0 && (i + 1) < argc)
+        {
+            i++;
+            if(strcmp(argv[i], "mobile") == 0)          topMetric = TOP_MOBILE;
+            else if(strcmp(argv[i], "discounts") == 0)  topMetric = TOP_DISCOUNTS;
+            else if(strcmp(argv[i], "fee") == 0)        topMetric = TOP_FEE;
+            else if(strcmp(argv[i], "net") == 0)        topMetric = TOP_NET;
+            else if(strcmp(argv[i], "total") == 0)      topMetric = TOP_TOTAL;
+            else if(strcmp(argv[i], "discount-share") == 0) topMetric = TOP_SHARE;
+            else
+            {
+                printf("Error: Can not rank by '%s'.\nMetrics are: mobile, discounts, fee, net, total, discount-share\n", argv[i]);
+                free(files);
+                return 1;
+            }
+        }
+        else if(strcmp(argv[i], "--of") == 0 && (i + 1) < argc)
+        {
+            i++;
+            if(strcmp(argv[i], "machine") == 0)
+                topMachines = true;
+            else if(strcmp(argv[i], "account") != 0)
+            {
+                printf("Error: Can not rank '%s'.\nChoices are: account, machine\n", argv[i]);
+                free(files);
+                return 1;
+            }
+        }
+        else if(strcmp(argv[i], "--compress") == 0 && (i + 1) < argc)
+        {
+            i++;
+            if(strcmp(argv[i], "gzip") == 0)
+                outputCodec = CODEC_GZIP;
+            else if(strcmp(argv[i], "zstd") == 0)
+                outputCodec = CODEC_ZSTD;
+            else if(strcmp(argv[i], "none") != 0)
+            {
+                printf("Error: Can not compress with '%s'.\nChoices are: gzip, zstd, none\n", argv[i]);
+                free(files);
+                return 1;
+            }
+        }
+        else if(strcmp(argv[i], "--format") == 0 && (i + 1) < argc)
+        {
+            i++;
+            if(strcmp(argv[i], "ndjson") == 0)
+                outputFormat = FORMAT_NDJSON;
+            else if(strcmp(argv[i], "csv") != 0)
+            {
+                printf("Error: Can not write '%s'.\nFormats are: csv, ndjson\n", argv[i]);
+                free(files);
+                return 1;
+            }
+        }
+        else if(strcmp(argv[i], "--arrow") == 0)
+        {
+            arrowOutput = true;
+        }
+        else if(strcmp(argv[i], "--index") == 0)
+        {
+            useIndex = true;
+        }
+        else if(strcmp(argv[i], "--reconcile") == 0)
+        {
+            reconcileRows = true;
+        }
+        else if(strcmp(argv[i], "--rows") == 0 && (i + 1) < argc)
+        {
+            i++;
+            if(sscanf(argv[i], "%d-%d", &firstRow, &lastRow) != 2 || firstRow < 1 || lastRow < firstRow)
+            {
+                printf("Error: Can not read rows '%s'.\nGive them as first-last, e.g. --rows 1000-2000\n", argv[i]);
+                free(files);
+                return 1;
+            }
+            useIndex = true; //the index is how we find row first
+        }
+        else if(strcmp(argv[i], "--stream") == 0)
+        {
+            streamInput = true;
+        }
+        else if(strcmp(argv[i], "--resume") == 0)
+        {
+            resumeRun = true;
+            streamInput = true; //only a streamed run leaves checkpoints
+        }
+        else if(strcmp(argv[i], "--no-checkpoint") == 0)
+        {
+            useCheckpoints = false;
+        }
+        else if(strcmp(argv[i], "--checkpoint-mb") == 0 && (i + 1) < argc)
+        {
+            checkpointBytes = atoll(argv[++i]) * 1024 * 1024;
+
+            if(checkpointBytes <= 0)
+            {
+                printf("Error: --checkpoint-mb needs a size in MB above 0.\n");
+                free(files);
+                return 1;
+            }
+        }
+        else if(strcmp(argv[i], "--mem-budget") == 0 && (i + 1) < argc)
+        {
+            memoryBudget = atoll(argv[++i]) * 1024 * 1024; //given in MB
+        }
+        else if(strcmp(argv[i], "--group-by") == 0 && (i + 1) < argc)
+        {
+            i++;
+            if(!addGroupSet(argv[i]))
+            {
+                printf("Error: Can not group by '%s'.\nColumns are: name, account, city, state, zip, tags, machine\n", argv[i]);
+                free(files);
+                return 1;
+            }
+        }
+        else
+        {
+            files[fileCount++] = argv[i];
+        }
+    }
+
+    //Options that clash are caught here, before any file is read
+    if(firstRow > 0 && (streamInput || usePipeline || fileCount == 0 || mergeOutput != NULL))
+    {
+        printf("Error: --rows needs a file and works with the chunked parser only, not --stream, --pipeline or --merge.\n");
+        free(files);
+        return 1;
+    }
+
+    for(i = 0; firstRow > 0 && i < fileCount; i++)
+    {
+        strncpy(filename, files[i], MAX_STRING_LEN - 1);
+        filename[MAX_STRING_LEN - 1] = '\0';
+        stripExtension(filename);
+
+        if(inputCodec(filename) != CODEC_NONE)
+        {
+            printf("Error: --rows can't seek into compressed %s, decompress it first.\n", filename);
+            free(files);
+            return 1;
+        }
+    }
+
+    if(mergeOutput != NULL)
+    {
+        mergeParsedFiles(files, fileCount);
+        free(files);
+        return exitStatus;
+    }
+
+    if(fileCount == 0)
+    {
+        strcpy(filename, "test1234");
+        run();
+    }
+
+    if(fileCount > 0 && !streamInput && !usePipeline)
+    {
+        runScheduler(files, fileCount);
+        fileCount = 0;
+    }
+
+    for(i = 0; i < fileCount; i++)
+    {
+        strncpy(filename, files[i], MAX_STRING_LEN - 1);
+        filename[MAX_STRING_LEN - 1] = '\0';
+
+        //We add the extension ourselves, so drop it if it was typed in
+        stripExtension(filename);
+
+        run();
+    }
+
+    free(files);
+    return exitStatus;
+}//END main
+
+//Function(s)
+void run()
+{
+    printf("Verifying File Exists...\n");
+
+    if(!verifyFileName())
+    {
+        printf("Skipping %s.\n", filename);
+        return;
+    }
+
+    printf("Reading Column Headers...\n");
+    parseHeaders();
+
+    printf("Parsing File Now...\n");
+    streaming = streamInput;
+
+    if(!(usePipeline ? parsePipeline() : parsePayRangeFile()))
+    {
+        printf("File is not in Display Name order, sorting it instead...\n");
+        streaming = false;
+
+        if(usePipeline)
+            parsePipeline();
+        else
+            parsePayRangeFile();
+    }
+
+    if(reconcileRows)
+    {
+        printf("Writing Reconciliation Report...\n");
+        writeReconcileReport(filename, &checks, 1);
+    }
+
+    if(groupSetCount > 0)
+    {
+        printf("Creating Rollup File...\n");
+        writeRollupFile();
+    }
+
+    if(streaming)//_parsed.csv was written while parsing, nothing to sort
+    {
+        printf("Completed! Check new file and rename it!\n");
+        printStats(&columns);
+        return;
+    }
+
+    printf("Sorting File Now...\n");
+    alternativeSort();
+
+    printf("Creating New File...\n");
+    writePayRangeFile();
+
+    printf("Completed! Check new file and rename it!\n");
+    printStats(&columns);
+
+    return;
+}
+
+int inputCodec(const char* base)
+{
+    //Which of base.csv, base.csv.gz & base.csv.zst is there, plain wins if there are several
+    FILE* stream;
+    char* s;
+    int codec;
+
+    for(codec = CODEC_NONE; codec <= CODEC_ZSTD; codec++)
+    {
+        s = concat(base, inputExtensions[codec]);
+        stream = fopen(s, "r");
+        free(s);
+
+        if(stream != NULL)
+        {
+            fclose(stream);
+            return codec;
+        }
+    }
+
+    return CODEC_NONE; //nothing there, openInput() gets to report it
+}//END inputCodec
+
+FILE* openInput(const char* base)
+{
+    /*
+    Opens base's .csv for reading. A compressed one is read through a pipe
+    from gzip/zstd, which decompresses in its own process while we parse,
+    so nothing decompressed is ever written to disk.
+    */
+
+    //Local Variable(s)
+    int codec = inputCodec(base);
+    char* s = concat(base, inputExtensions[codec]);
+    FILE* stream;
+
+    if(codec == CODEC_NONE)
+        stream = fopen(s, "r");
+    else
+        stream = openPipe(decompressors[codec], "", s, "r");
+
+    free(s);
+    return stream;
+}//END openInput
+
+bool closeInput(FILE* stream, const char* base)
+{
+    //Local Variable(s)
+    int codec = inputCodec(base);
+    char* s;
+    bool finished;
+
+    if(codec == CODEC_NONE)
+    {
+        fclose(stream);
+        return true;
+    }
+
+    s = concat(base, inputExtensions[codec]);
+    finished = closePipe(stream, decompressors[codec], s); //waits for the decompressor to exit
+    free(s);
+    return finished;
+}//END closeInput
+
+bool closePipe(FILE* stream, const char* program, const char* path)
+{
+    /*
+    popen() succeeds even when program isn't installed, the shell just
+    exits 127 and we read nothing. So how the child ended is the only way
+    to tell a missing or failing gzip/zstd from an empty file.
+    */
+
+    //Local Variable(s)
+    int status = pclose(stream);
+
+#ifndef _WIN32
+    if(status != -1)//a signal counts as 128 + its number, the way the shell reports it
+        status = WIFSIGNALED(status) ? 128 + WTERMSIG(status) : WEXITSTATUS(status);
+
+    if(status == 128 + SIGPIPE)//we stopped reading early, e.g. after the headers
+        return true;
+#endif
+
+    if(status == 0)
+        return true;
+
+    if(status == 127)
+        printf("Error: '%s' is not installed, it is needed for %s.\n", program, path);
+    else
+        printf("Error: '%s' failed on %s (exit %d), it is incomplete.\n", program, path, status);
+
+    exitStatus = 1;
+    return false;
+}//END closePipe
+
+int pathCodec(const char* path)
+{
+    //By extension, for files named on the command line like the --merge inputs
+    int length = strlen(path);
+
+    if(length > 3 && strcmp(path + length - 3, ".gz") == 0)
+        return CODEC_GZIP;
+    if(length > 4 && strcmp(path + length - 4, ".zst") == 0)
+        return CODEC_ZSTD;
+
+    return CODEC_NONE;
+}//END pathCodec
+
+FILE* openPipe(const char* program, const char* redirect, const char* path, const char* mode)
+{
+    //Runs "program redirect 'path'", path is single quoted for the shell so a ' has to end the quote to get in
+    char* command = (char*)malloc(strlen(program) + strlen(redirect) + 4 * strlen(path) + 8);
+    FILE* stream;
+    int length = sprintf(command, "%s %s'", program, redirect);
+    int i;
+
+    for(i = 0; path[i] != '\0'; i++)
+    {
+        if(path[i] == '\'')
+            length += sprintf(command + length, "'\\''");
+        else
+            command[length++] = path[i];
+    }
+
+    strcpy(command + length, "'");
+
+    stream = popen(command, mode);
+    free(command);
+    return stream;
+}//END openPipe
+
+FILE* openOutput(const char* name)
+{
+    /*
+    Opens name (plus .gz/.zst with --compress) for writing. Compressed
+    output is piped through pigz/gzip or zstd -T0, which compress blocks
+    on their own threads while we keep formatting rows.
+    */
+
+    //Local Variable(s)
+    static int hasPigz = -1; //checked the first time it's needed
+    const char* program = compressors[outputCodec];
+    char* s = concat(name, outputExtensions[outputCodec]);
+    FILE* stream;
+
+    if(outputCodec == CODEC_GZIP)
+    {
+#ifndef _WIN32
+        if(hasPigz < 0)
+            hasPigz = (system("command -v pigz > /dev/null 2>&1") == 0);
+#else
+        hasPigz = 0;
+#endif
+        if(hasPigz)
+            program = "pigz -c"; //block parallel gzip, same file format
+    }
+
+    if(outputCodec == CODEC_NONE)
+        stream = fopen(s, "w");
+    else
+        stream = openPipe(program, "> ", s, "w");
+
+    free(s);
+    return stream;
+}//END openOutput
+
+void closeOutput(FILE* stream)
+{
+    if(outputCodec == CODEC_NONE)
+        fclose(stream);
+    else
+        closePipe(stream, compressors[outputCodec], "compressed output"); //waits for the compressor to finish the file
+    return;
+}//END closeOutput
+
+bool verifyFileName()
+{
+    //Local Variable(s)
+    int flag = NOTVERIFIED;
+    char str[MAX_STRING_LEN];
+    FILE* stream;
+
+    while(flag == NOTVERIFIED)
+    {
+        stream = openInput(filename); //Attempt to Open File, .csv or a compressed .csv
+
+        if(stream == NULL) //If failed to open file
+        {
+            printf("Error: File failing to open.\nPlease verify the name is correct and try again: ");
+            gets(str); //Ask for correct filename && try again
+            strcpy(filename, str);
+            printf("\n");
+        }
+        else if(!closeInput(stream, filename))//a compressed file whose decompressor isn't there or fails
+        {
+            return false;
+        }
+        else
+        {
+            printf("File Found...\n");
+            flag = VERIFIED;
+        }
+    }
+
+    return true;
+}//END verifyFileName
+
+void parseHeaders()
+{
+    //Local Variable(s)
+    char str[MAX_CSV_LEN];
+    struct lineBuffer line = { str, MAX_CSV_LEN, 0, false };
+    char name[MAX_HEADER_LEN];
+    char *cursor;
+    char *token;
+    FILE* stream;
+    int col = 0;
+    int header;
+
+    memset(&columns, 0, sizeof(struct columnMap)); //forget the last file's columns
+
+    if(headerSeed == 0)
+        initHeaderTable();
+
+    stream = openInput(filename); //Open File
+    cursor = readLine(stream, &line); //Get First Line (column headers)
+
+    if(cursor == NULL)//empty file, no columns
+        cursor = strcpy(str, "");
+
+    sniffDialect(stream, cursor, &columns);
+
+    if(columns.bom)
+        cursor += 3;
+
+    while((token = nextQuoted(&cursor, columns.delim)) != NULL) //while there are tokens remaining, empty ones still count
+    {
+        col++;
+        header = lookupHeader(name, normalizeHeader(token, name));
+
+        if(header >= 0)
+        {
+            *(int*)((char*)&columns + headerFields[header]) = col; //retain col # of this header
+        }
+        else if(header == -2)//never heard of it
+        {
+            if(columns.unknownColumns++ == 0)
+                strcpy(columns.firstUnknown, name);
+        }
+    }
+
+    columns.totalColumns = col;//Retain total amount of columns seen in the file
+    compilePlan(&columns);
+    columns.knownLayout = isKnownLayout(&columns);
+
+    if(columns.knownLayout && !columns.quoted)//quoted fields need the generic tokenizer
+    {
+        if(columns.delim == ',')
+            columns.knownParser = columns.crlf ? knownCommaCRLF : knownComma;
+        else if(columns.delim == ';')
+            columns.knownParser = columns.crlf ? knownSemicolonCRLF : knownSemicolon;
+        else
+            columns.knownParser = columns.crlf ? knownTabCRLF : knownTab;
+    }
+
+    closeInput(stream, filename); //Close File
+    freeLine(&line);
+
+    return;
+}//END parseHeaders
+
+void sniffDialect(FILE* stream, const char* header, struct columnMap* map)
+{
+    /*
+    Works out how the file was written from its header line and the first
+    SNIFF_LINES lines after it. PayRange writes ',' and "\n", a re-save in
+    Excel can give a BOM, "\r\n" and ';'. The delimiter is whichever of
+    ',' ';' and tab the header has most of outside quotes. Fields are
+    quoted if a quote opens right after a delimiter and closes again on the
+    same line, "" inside counts as text. The multi-line Location opens a
+    quote that runs off the end of the line, with or without text after
+    it, so an ordinary export still gets its fixed kernel. Line ends are
+    taken from the data lines, Location's inner lines can differ.
+    */
+
+    //Local Variable(s)
+    char buffer[MAX_CSV_LEN];
+    struct lineBuffer line = { buffer, MAX_CSV_LEN, 0, false };
+    char* str;
+    int counts[3] = { 0, 0, 0 }; //',' ';' '\t'
+    const char* pos;
+    const char* end;
+    bool inQuotes = false;
+    int length = strlen(header);
+    int lines;
+
+    map->bom = ((unsigned char)header[0] == 0xEF && (unsigned char)header[1] == 0xBB && (unsigned char)header[2] == 0xBF);
+    map->crlf = (length >= 2 && header[length - 2] == '\r' && header[length - 1] == '\n');
+
+    for(pos = header; *pos != '\0'; pos++)
+    {
+        if(*pos == '"')
+            inQuotes = !inQuotes;
+        else if(!inQuotes && *pos == ',')
+            counts[0]++;
+        else if(!inQuotes && *pos == ';')
+            counts[1]++;
+        else if(!inQuotes && *pos == '\t')
+            counts[2]++;
+    }
+
+    map->delim = ',';
+
+    if(counts[1] > counts[0] && counts[1] >= counts[2])
+        map->delim = ';';
+    else if(counts[2] > counts[0] && counts[2] > counts[1])
+        map->delim = '\t';
+
+    map->quoted = false;
+
+    for(lines = 0; lines < SNIFF_LINES && (str = readLine(stream, &line)) != NULL; lines++)
+    {
+        length = strlen(str);
+
+        if(length >= MAX_STRING_LEN && str[length - 1] == '\n')//data lines decide the line ends, not the header or Location
+            map->crlf = (str[length - 2] == '\r');
+
+        for(pos = strchr(str, map->delim); pos != NULL; pos = strchr(pos + 1, map->delim))
+        {
+            if(pos[1] != '"')
+                continue;
+
+            for(end = pos + 2; *end != '\0' && !(*end == '"' && end[1] != '"'); end += (*end == '"') ? 2 : 1)
+                ; //find the closing quote, stepping over ""
+
+            if(*end == '"')//closed on this line, a quoted field and not Location
+                map->quoted = true;
+        }
+    }
+
+    freeLine(&line);
+
+    return;
+}//END sniffDialect
+
+int normalizeHeader(const char* token, char* name)
+{
+    /*
+    Lower case, no quotes, no BOM, CR or newline, runs of spaces made one
+    space and none at either end. Returns the length.
+    */
+
+    //Local Variable(s)
+    const unsigned char* in = (const unsigned char*)token;
+    int length = 0;
+    bool space = false;
+
+    if(in[0] == 0xEF && in[1] == 0xBB && in[2] == 0xBF)//UTF-8 BOM, Excel puts it on the first header
+        in += 3;
+
+    for(; *in != '\0' && length < MAX_HEADER_LEN - 1; in++)
+    {
+        if(*in == ' ' || *in == '\t' || *in == '\r' || *in == '\n')
+        {
+            space = (length > 0);
+        }
+        else if(*in != '"')
+        {
+            if(space)
+                name[length++] = ' ';
+
+            space = false;
+            name[length++] = tolower(*in);
+        }
+    }
+
+    name[length] = '\0';
+    return length;
+}//END normalizeHeader
+
+unsigned long long headerHash(const char* name, int length, unsigned long long seed)
+{
+    //FNV-1a, the seed moves the aliases around until none of them share a slot
+    unsigned long long hash = 14695981039346656037ULL ^ seed;
+    int i;
+
+    for(i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)name[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash | 1; //0 marks an empty slot
+}//END headerHash
+
+void initHeaderTable()
+{
+    /*
+    Builds a perfect hash of HEADER_ALIASES: seeds are tried until every
+    alias lands in a slot of its own, so a lookup is one hash and one slot
+    with nothing to probe. Run once, the first time headers are read.
+    */
+
+    //Local Variable(s)
+    #define X(alias, header) { alias, header },
+    static const struct { const char* alias; int header; } aliases[] = { HEADER_ALIASES(X) };
+    #undef X
+    int count = sizeof(aliases) / sizeof(aliases[0]);
+    unsigned long long seed;
+    unsigned long long hash;
+    int i;
+
+    for(seed = 1; ; seed++)
+    {
+        memset(headerTable, 0, sizeof(headerTable));
+
+        for(i = 0; i < count; i++)
+        {
+            hash = headerHash(aliases[i].alias, strlen(aliases[i].alias), seed);
+
+            if(headerTable[hash & (HEADER_SLOTS - 1)].hash != 0)//taken, try the next seed
+                break;
+
+            headerTable[hash & (HEADER_SLOTS - 1)].hash = hash;
+            headerTable[hash & (HEADER_SLOTS - 1)].header = aliases[i].header;
+        }
+
+        if(i == count)
+            break;
+    }
+
+    headerSeed = seed;
+
+    return;
+}//END initHeaderTable
+
+int lookupHeader(const char* name, int length)
+{
+    //HDR_* for a normalized header, -2 if it isn't one we know
+    unsigned long long hash = headerHash(name, length, headerSeed);
+    headerSlot* slot = &headerTable[hash & (HEADER_SLOTS - 1)];
+
+    return (slot->hash == hash) ? slot->header : -2;
+}//END lookupHeader
+
+bool isKnownLayout(const struct columnMap* map)
+{
+    //Does the compiled plan do exactly what parseKnownLine() does
+    if(map->totalColumns != PAYRANGE_COLUMNS)
+        return false;
+
+    #define X(col, header, act, field, fill) \
+        if(map->action[col] != ACT_##act || (ACT_##act != ACT_SKIP && map->slot[col] != fill)) \
+            return false;
+    PAYRANGE_LAYOUT(X)
+    #undef X
+
+    return true;
+}//END isKnownLayout
+
+void compilePlan(struct columnMap* map)
+{
+    //Turns the column #s into the action table parseLine() runs off of
+    memset(map->action, ACT_SKIP, sizeof(map->action));
+    map->lastColumn = 0;
+
+    planColumn(map, map->dName, ACT_NAME, 0);
+    planColumn(map, map->mobileAmt, ACT_MONEY, AMOUNT_MOBILE);
+    planColumn(map, map->discountAmt, ACT_MONEY, AMOUNT_DISCOUNT);
+    planColumn(map, map->feeAmt, ACT_MONEY, AMOUNT_FEE);
+    planColumn(map, map->netAmt, ACT_MONEY, AMOUNT_NET);
+    planColumn(map, map->city, ACT_DICT, DICT_CITY);
+    planColumn(map, map->state, ACT_DICT, DICT_STATE);
+    planColumn(map, map->zipCode, ACT_DICT, DICT_ZIP);
+    planColumn(map, map->tags, ACT_DICT, DICT_TAGS);
+    planColumn(map, map->machineId, ACT_DICT, DICT_MACHINE);
+
+    return;
+}//END compilePlan
+
+void planColumn(struct columnMap* map, int col, int action, int slot)
+{
+    if(col <= 0 || col > MAX_COLUMNS)//file doesn't have it, or too far out to plan
+        return;
+
+    map->action[col] = action;
+    map->slot[col] = slot;
+
+    if(col > map->lastColumn)
+        map->lastColumn = col;
+
+    return;
+}//END planColumn
+
+void nullify(struct row* temp)
+{
+    temp->nameId = 0; //ID 0 is the empty name
+    setField(&temp->mobileAmt, "");
+    setField(&temp->discountAmt, "");
+    setField(&temp->feeAmt, "");
+    setField(&temp->netAmt, "");
+    temp->city = 0; //code 0 is "" in every dictionary
+    temp->state = 0;
+    temp->zipCode = 0;
+    temp->tags = 0;
+    temp->machineId = 0;
+    temp->next = NULL;
+
+    return;
+}
+
+bool parsePayRangeFile()
+{
+    //Local Variable(s)
+    FILE* stream;
+    char buffer[MAX_CSV_LEN];
+    struct lineBuffer line = { buffer, MAX_CSV_LEN, 0, false }; //grows for a line longer than buffer
+    char* str;
+    int currCol = 2;//Once we grab a line with data we're interested in, we'll actually be in column two (based on csv file format)
+    struct row* temp = (struct row*)malloc(sizeof(struct row));
+
+    nullify(temp);
+    free(checks.found); //a parse that has to start over checks its rows again
+    memset(&checks, 0, sizeof(struct centBatch));
+
+    if(streaming)
+        startStream();
+
+    stream = openInput(filename); //Open File, a compressed one is decompressed as we read it
+    str = readLine(stream, &line); //Get First Line (discard, do not need as it is only headers)
+    inputRead = (str != NULL) ? strlen(str) : 0;
+
+    if(streaming && resumedFrom > inputRead)//skip what the checkpoint already covers
+    {
+        if(inputCodec(filename) == CODEC_NONE)
+            fseek(stream, resumedFrom, SEEK_SET);
+        else
+            while(resumedFrom > inputRead && (str = readLine(stream, &line)) != NULL)
+                inputRead += strlen(str);
+
+        inputRead = resumedFrom;
+    }
+
+    recordStart = inputRead;
+
+    while((str = readLine(stream, &line)) != NULL)//while there are lines left to read, get one.
+    {
+        inputRead += strlen(str);
+
+        if(strlen(str) < MAX_STRING_LEN)
+            continue; //skip this line, not what we're looking for
+
+        if(parseLine(str, temp, &currCol, &columns))//found last item for this node, save it and create new node
+        {
+            //showNode(temp);
+
+            if(moneyExists(temp))//Only add node to list if it has money
+            {
+                //Change the Strings: '$x.xx' to cents, used when totaling & writing new csv file
+                convertRow(temp);
+
+                if(reconcileRows)
+                    reconcileRow(&checks, temp);
+
+                if(!keepRow(temp))//streaming and the file is out of order, stop here
+                {
+                    free(temp);
+                    closeInput(stream, filename);
+                    freeLine(&line);
+                    abandonStream();
+                    return false;
+                }
+
+                temp = (struct row*)malloc(sizeof(struct row)); //Allocate Mem for Next Node
+
+                if(temp == NULL && head != NULL)//out of memory before the budget, spill and try again
+                {
+                    spillRun();
+                    temp = (struct row*)malloc(sizeof(struct row));
+                }
+            }
+            else
+            {
+                //printf("\nNot Adding Node Now!");
+            }
+
+            nullify(temp); //start next node blank
+            totalNodes++;//increment our totalNodes(total rows) counter
+            recordStart = inputRead; //next row starts after this line
+        }
+    }
+
+    free(temp); //last node was never filled in
+
+    if(streaming)//every account but the last was written as it finished
+        finishStream();
+    else if(runs.count > 0 && head != NULL)//rest of the rows become the last run so they all merge together
+        spillRun();
+
+    closeInput(stream, filename);
+    freeLine(&line);
+
+    return true;
+}//End parsePayRangeFile
+
+bool parseLine(char* str, struct row* temp, int* currCol, const struct columnMap* map)
+{
+    /*
+    Each column's token is handled the way the plan compiled in
+    parseHeaders() says. Unwanted columns are stepped over without being
+    cut out, and once the last wanted column is stored the row is done if
+    the rest of it is on this line, so those columns are never looked at.
+    */
+
+    //Local Variable(s)
+    char *cursor = str; //where the next token starts, so several threads can tokenize at once
+    char *token;
+    int col;
+
+    if(map->knownParser != NULL && *currCol == 2)//start of a row in the usual layout, use its kernel
+        return map->knownParser(str, temp, currCol);
+
+    while(cursor != NULL) //while there are tokens remaining
+    {
+        col = (*currCol <= MAX_COLUMNS) ? *currCol : 0;
+
+        /*
+        With quoted fields a quote after a delimiter opens one, but the
+        first token on a line is the end of the multi-line Location, its
+        quote is the closing one, so it is stepped over plainly.
+        */
+        if(map->action[col] == ACT_SKIP)
+        {
+            cursor = (map->quoted && cursor != str) ? skipQuoted(cursor, map->delim) : strchr(cursor, map->delim);
+
+            if(cursor != NULL)
+                cursor++;
+        }
+        else
+        {
+            token = (map->quoted && cursor != str) ? nextQuoted(&cursor, map->delim) : nextToken(&cursor, map->delim);
+
+            if(cursor == NULL)//last token on the line
+                token[strcspn(token, "\r\n")] = '\0';
+
+            switch(map->action[col])
+            {
+                case ACT_NAME:
+                    temp->nameId = internName(token);
+                    break;
+                case ACT_MONEY:
+                    setField((struct field*)((char*)temp + amountFields[map->slot[col]]), token);
+                    break;
+                case ACT_DICT:
+                    *(unsigned*)((char*)temp + codeFields[map->slot[col]]) = internString(&dictionaries[map->slot[col]], token);
+                    break;
+            }
+        }
+
+        if(*currCol == map->totalColumns)//found last item for this node
+        {
+            *currCol = 2; //reset counter
+            return true;
+        }
+
+        if(*currCol == map->lastColumn && cursor != NULL && strchr(cursor, '\n') != NULL)
+        {
+            *currCol = 2; //nothing else wanted & the row ends on this line
+            return true;
+        }
+
+        (*currCol)++; //adjust column over
+    }
+
+    return false; //row carries on into the next line
+}//END parseLine
+
+/*
+One step of a parseKnownLine() kernel per PAYRANGE_LAYOUT column. If the
+line ran out before this column the row carries on into the next line
+from here, same as parseLine(). delim and lineEnd are constants in each
+kernel so they fold into the code.
+*/
+#define KNOWN_SKIP(field, slot) \
+    cursor = strchr(cursor, delim); \
+    if(cursor != NULL) \
+        cursor++;
+#define KNOWN_TOKEN() \
+    token = nextToken(&cursor, delim); \
+    if(cursor == NULL && (end = strchr(token, lineEnd)) != NULL) \
+        *end = '\0';
+#define KNOWN_NAME(field, slot)  KNOWN_TOKEN() temp->field = internName(token);
+#define KNOWN_MONEY(field, slot) KNOWN_TOKEN() setField(&temp->field, token);
+#define KNOWN_DICT(field, slot)  KNOWN_TOKEN() temp->field = internString(&dictionaries[slot], token);
+#define KNOWN_STEP(col, header, action, field, slot) \
+    if(col >= 2) \
+    { \
+        if(cursor == NULL) \
+        { \
+            *currCol = col; \
+            return false; \
+        } \
+        KNOWN_##action(field, slot) \
+    }
+
+/*
+parseLine() for the usual PayRange layout, one kernel per unquoted
+dialect, all generated from PAYRANGE_LAYOUT. Every column's handling is
+fixed in the code, so there is no per-column lookup or dispatch at all.
+*/
+#define KNOWN_PARSER(name, delimiter, lastChar) \
+bool name(char* str, struct row* temp, int* currCol) \
+{ \
+    const char delim = delimiter; \
+    const char lineEnd = lastChar; /* '\r' cuts "\r\n" */ \
+    char *cursor = str; \
+    char *token; \
+    char *end; \
+ \
+    PAYRANGE_LAYOUT(KNOWN_STEP) \
+ \
+    *currCol = 2; /* Net was the last column, row is done */ \
+    return true; \
+}
+
+KNOWN_PARSER(knownComma, ',', '\n')
+KNOWN_PARSER(knownCommaCRLF, ',', '\r')
+KNOWN_PARSER(knownSemicolon, ';', '\n')
+KNOWN_PARSER(knownSemicolonCRLF, ';', '\r')
+KNOWN_PARSER(knownTab, '\t', '\n')
+KNOWN_PARSER(knownTabCRLF, '\t', '\r')
+
+#undef KNOWN_PARSER
+#undef KNOWN_STEP
+#undef KNOWN_DICT
+#undef KNOWN_MONEY
+#undef KNOWN_NAME
+#undef KNOWN_TOKEN
+#undef KNOWN_SKIP
+
+bool keepRow(struct row* temp)
+{
+    if(isFeeOnly(temp))//kept out of the listing & the account totals, printTotal() gives them their own section
+    {
+        if(streaming)//they still have to be in order, topFeeRows() relies on it
+        {
+            if(compareNames(lastName, temp->nameId) > 0)
+                return false;
+
+            lastName = temp->nameId;
+        }
+
+        if(groupSetCount > 0)
+            groupRow(&rollups, temp);
+
+        keepFeeRow(temp);
+        keptRows++;
+        return true;
+    }
+
+    if(streaming)
+    {
+        if(compareNames(lastName, temp->nameId) > 0)//out of Display Name order, streaming won't work
+            return false;
+
+        if(head != NULL && !isNextMatch(tail->nameId, temp->nameId))//new account, the last one is complete
+            flushAccount();
+
+        lastName = temp->nameId;
+    }
+
+    if(groupSetCount > 0)
+        groupRow(&rollups, temp); //add row to every rollup level while we have it
+
+    addToAccount(&accounts, temp);
+
+    if(head == NULL)
+    {
+        //printf("\nAdding Head Now!");
+        head = temp;//link head to the first node created and assigned
+    }
+    else
+    {
+        //printf("\nAdding Middle of List Now!");
+        tail->next = temp;
+    }
+
+    tail = temp;
+    runRows++;
+    keptRows++;
+
+    if(!streaming && memoryBudget > 0 && (long long)runRows * (long long)sizeof(struct row) >= memoryBudget)
+        spillRun(); //over budget, move what we have to disk
+
+    return true;
+}//END keepRow
+
+bool isFeeOnly(struct row* temp)
+{
+    //No Mobile & no Discounts, only a Fee (the Net is minus the Fee)
+    return temp->mobileCents == 0 && temp->discountCents == 0 && temp->feeCents != 0;
+}//END isFeeOnly
+
+long long rowTotal(long long mobile, long long discount, long long fee)
+{
+    //Mobile minus Discounts, a fee-only row has nothing but its Fee so it is minus the Fee
+    return (mobile == 0 && discount == 0) ? -fee : mobile - discount;
+}//END rowTotal
+
+void keepFeeRow(struct row* temp)
+{
+    //Fee-only rows wait on the root list in the order they come, printTotal() sorts & writes them
+    if(root == NULL)
+        root = temp;
+    else
+        rootTail->next = temp;
+
+    rootTail = temp;
+    feeOnlyRows++;
+
+    return;
+}//END keepFeeRow
+
+void sortFeeRows()
+{
+    //Display Name order, like the rows they are listed after
+    root = sortList(root);
+
+    for(rootTail = root; rootTail != NULL && rootTail->next != NULL; rootTail = rootTail->next)
+        ; //find the new tail
+
+    return;
+}//END sortFeeRows
+
+void topFeeRows(unsigned nameId, bool all)
+{
+    /*
+    Fee-only rows aren't in the listing, but --top has to see them in name
+    order or an account would be offered twice. Whoever writes the listing
+    calls this before each row with its name, printTotal() for the rest.
+    */
+    struct row* temp = (feeOffered != NULL) ? feeOffered->next : root;
+
+    for(; topCount > 0 && temp != NULL && (all || compareNames(temp->nameId, nameId) <= 0); temp = temp->next)
+    {
+        topRow(temp->nameId, temp->mobileCents, temp->discountCents, temp->feeCents, temp->netCents);
+        feeOffered = temp;
+    }
+
+    return;
+}//END topFeeRows
+
+void runScheduler(char** files, int fileCount)
+{
+    //Local Variable(s)
+    struct task* temp;
+    int i;
+
+    if(threadCount <= 0)
+        threadCount = coreCount();
+
+    workers = (struct worker*)calloc(threadCount, sizeof(struct worker));
+
+    for(i = 0; i < threadCount; i++)
+    {
+        workers[i].id = i;
+        workers[i].capacity = 64;
+        workers[i].tasks = (struct task**)malloc(workers[i].capacity * sizeof(struct task*));
+        pthread_mutex_init(&workers[i].lock, NULL);
+    }
+
+    //Hand the file tasks out round robin, stealing evens out the rest
+    atomic_store(&pendingTasks, fileCount);
+
+    for(i = 0; i < fileCount; i++)
+    {
+        temp = (struct task*)calloc(1, sizeof(struct task));
+        temp->type = TASK_FILE;
+        temp->job = (struct job*)calloc(1, sizeof(struct job));
+
+        strncpy(temp->job->filename, files[i], MAX_STRING_LEN - 1);
+
+        //We add the extension ourselves, so drop it if it was typed in
+        stripExtension(temp->job->filename);
+
+        pushTask(&workers[i % threadCount], temp);
+    }
+
+    printf("Running %d File(s) on %d Worker(s)...\n", fileCount, threadCount);
+
+    for(i = 1; i < threadCount; i++)
+        pthread_create(&workers[i].thread, NULL, workerLoop, &workers[i]);
+
+    workerLoop(&workers[0]); //main thread is worker 0
+
+    for(i = 1; i < threadCount; i++)
+        pthread_join(workers[i].thread, NULL);
+
+    for(i = 0; i < threadCount; i++)
+    {
+        pthread_mutex_destroy(&workers[i].lock);
+        free(workers[i].tasks);
+    }
+
+    free(workers);
+    workers = NULL;
+    return;
+}//END runScheduler
+
+void* workerLoop(void* arg)
+{
+    //Local Variable(s)
+    struct worker* self = (struct worker*)arg;
+    struct task* temp;
+    unsigned seen;
+
+    while(atomic_load(&pendingTasks) > 0)
+    {
+        pthread_mutex_lock(&idleLock);
+        seen = taskPosts;
+        pthread_mutex_unlock(&idleLock);
+
+        temp = popTask(self);
+
+        if(temp == NULL)
+            temp = stealTask(self);
+
+        if(temp == NULL)//nothing to do right now, sleep until someone splits a file or the last task ends
+        {
+            pthread_mutex_lock(&idleLock);
+
+            while(taskPosts == seen && atomic_load(&pendingTasks) > 0)
+                pthread_cond_wait(&workReady, &idleLock);
+
+            pthread_mutex_unlock(&idleLock);
+            continue;
+        }
+
+        if(temp->type == TASK_FILE)
+            runFileTask(self, temp->job);
+        else
+            runChunkTask(self, temp->job, temp->chunk);
+
+        free(temp);
+
+        if(atomic_fetch_sub(&pendingTasks, 1) == 1)//that was the last one, let the sleepers out
+        {
+            pthread_mutex_lock(&idleLock);
+            pthread_cond_broadcast(&workReady);
+            pthread_mutex_unlock(&idleLock);
+        }
+    }
+
+    return NULL;
+}//END workerLoop
+
+void pushTask(struct worker* self, struct task* temp)
+{
+    int i;
+    struct task** grown;
+
+    pthread_mutex_lock(&self->lock);
+
+    if(self->bottom - self->top == self->capacity)//full, double it
+    {
+        grown = (struct task**)malloc(self->capacity * 2 * sizeof(struct task*));
+
+        for(i = self->top; i < self->bottom; i++)
+            grown[i - self->top] = self->tasks[i % self->capacity];
+
+        free(self->tasks);
+        self->tasks = grown;
+        self->bottom -= self->top;
+        self->top = 0;
+        self->capacity *= 2;
+    }
+
+    self->tasks[self->bottom % self->capacity] = temp;
+    self->bottom++;
+
+    pthread_mutex_unlock(&self->lock);
+
+    pthread_mutex_lock(&idleLock);//wake one idle worker to steal it
+    taskPosts++;
+    pthread_cond_signal(&workReady);
+    pthread_mutex_unlock(&idleLock);
+    return;
+}//END pushTask
+
+struct task* popTask(struct worker* self)
+{
+    struct task* temp = NULL;
+
+    pthread_mutex_lock(&self->lock);
+
+    if(self->bottom > self->top)//newest first, its file is still warm in cache
+    {
+        self->bottom--;
+        temp = self->tasks[self->bottom % self->capacity];
+    }
+
+    pthread_mutex_unlock(&self->lock);
+    return temp;
+}//END popTask
+
+struct task* stealTask(struct worker* self)
+{
+    //Local Variable(s)
+    struct worker* victim;
+    struct task* temp = NULL;
+    int i;
+
+    for(i = 1; i < threadCount && temp == NULL; i++)
+    {
+        victim = &workers[(self->id + i) % threadCount];
+
+        pthread_mutex_lock(&victim->lock);
+
+        if(victim->bottom > victim->top)//oldest first, chunks of the big file queued first
+        {
+            temp = victim->tasks[victim->top % victim->capacity];
+            victim->top++;
+        }
+
+        pthread_mutex_unlock(&victim->lock);
+    }
+
+    return temp;
+}//END stealTask
+
+void runFileTask(struct worker* self, struct job* work)
+{
+    //Local Variable(s)
+    FILE* stream;
+    char str[MAX_CSV_LEN];
+    struct lineBuffer line = { str, MAX_CSV_LEN, 0, false };
+    struct task* temp;
+    int i;
+
+    work->codec = inputCodec(work->filename);
+    stream = openInput(work->filename);
+
+    if(stream == NULL)
+    {
+        printf("Error: %s failing to open, skipping it.\n", work->filename);
+        free(work);
+        return;
+    }
+
+    if(work->codec != CODEC_NONE && !closeInput(stream, work->filename))//its decompressor isn't there or fails
+    {
+        printf("Skipping %s.\n", work->filename);
+        free(work);
+        return;
+    }
+
+    //parseHeaders() fills the shared column globals, copy them out under the lock
+    pthread_mutex_lock(&outputLock);
+    strcpy(filename, work->filename);
+    parseHeaders();
+    work->columns = columns;
+    pthread_mutex_unlock(&outputLock);
+
+    if(work->codec == CODEC_NONE)
+    {
+        readLine(stream, &line); //skip the headers
+        freeLine(&line);
+        work->dataStart = ftell(stream);
+        fseek(stream, 0, SEEK_END);
+        work->fileSize = ftell(stream);
+        closeInput(stream, work->filename);
+
+        work->chunkCount = (int)((work->fileSize - work->dataStart) / CHUNK_BYTES) + 1;
+
+        if(useIndex)
+            prepareIndex(work);
+    }
+    else
+    {
+        work->chunkCount = 1; //no seeking into the middle of a compressed stream, main() keeps --rows away
+    }
+
+    work->chunkHeads = (struct row**)calloc(work->chunkCount, sizeof(struct row*));
+    work->chunkFees = (struct row**)calloc(work->chunkCount, sizeof(struct row*));
+    work->chunkRuns = (struct runList*)calloc(work->chunkCount, sizeof(struct runList));
+    work->chunkRead = (int*)calloc(work->chunkCount, sizeof(int));
+    work->chunkKept = (int*)calloc(work->chunkCount, sizeof(int));
+    work->partials = (struct accountTable*)calloc(threadCount, sizeof(struct accountTable));
+    work->rollups = (groupSetCount > 0) ? (struct groupTable*)calloc(threadCount, sizeof(struct groupTable)) : NULL;
+    work->chunkChecks = reconcileRows ? (struct centBatch*)calloc(work->chunkCount, sizeof(struct centBatch)) : NULL;
+
+    if(useSharedTotals && threadCount > 1 && work->chunkCount > 1)//more than one producer for this file
+        sharedMapInit(&work->shared);
+    atomic_store(&work->chunksLeft, work->chunkCount);
+
+    //Count the chunks as pending before any of them can finish
+    atomic_fetch_add(&pendingTasks, work->chunkCount);
+
+    for(i = 0; i < work->chunkCount; i++)
+    {
+        temp = (struct task*)calloc(1, sizeof(struct task));
+        temp->type = TASK_CHUNK;
+        temp->job = work;
+        temp->chunk = i;
+        pushTask(self, temp);
+    }
+
+    return;
+}//END runFileTask
+
+void runChunkTask(struct worker* self, struct job* work, int chunk)
+{
+    //Local Variable(s)
+    FILE* stream;
+    char buffer[MAX_CSV_LEN];
+    struct lineBuffer line = { buffer, MAX_CSV_LEN, 0, false };
+    char* str;
+    long start = chunkOffset(work, chunk);
+    long end = chunkOffset(work, chunk + 1);
+    struct row* list = NULL;
+    struct row* tail = NULL;
+    struct row* fees = NULL; //fee-only rows of this chunk, in file order
+    struct row* feeTail = NULL;
+    struct row* temp = (struct row*)malloc(sizeof(struct row));
+    long long budgetRows = memoryBudget / (long long)sizeof(struct row) / 2 / threadCount; //this task's share of half of --mem-budget
+    long long listRows = 0;
+    int currCol = 2;
+
+    nullify(temp);
+    stream = openInput(work->filename);
+
+    /*
+    Lines belong to the chunk they start in. Unless we start right after
+    the headers, back up one byte and throw away the rest of that line,
+    the chunk before us reads it. With an index chunks start on a record
+    so there is nothing to throw away.
+    */
+    if(work->codec != CODEC_NONE)//one chunk, just read past the headers
+    {
+        readLine(stream, &line);
+    }
+    else if(start > work->dataStart && work->index.count == 0)
+    {
+        fseek(stream, start - 1, SEEK_SET);
+        readLine(stream, &line);
+    }
+    else
+    {
+        fseek(stream, start, SEEK_SET);
+    }
+
+    while(ftell(stream) < end && (str = readLine(stream, &line)) != NULL)
+    {
+        if(strlen(str) < MAX_STRING_LEN || !parseLine(str, temp, &currCol, &work->columns))
+            continue;
+
+        work->chunkRead[chunk]++;
+
+        if(moneyExists(temp))
+        {
+            convertRow(temp);
+
+            if(work->chunkChecks != NULL)
+                reconcileRow(&work->chunkChecks[chunk], temp);
+
+            if(work->rollups != NULL)
+                groupRow(&work->rollups[self->id], temp); //this worker's own table, fee-only rows too
+
+            if(isFeeOnly(temp))//their own list, finishJob() hands them to printTotal()
+            {
+                if(fees == NULL)
+                    fees = temp;
+                else
+                    feeTail->next = temp;
+
+                feeTail = temp;
+                work->chunkKept[chunk]++;
+                temp = (struct row*)malloc(sizeof(struct row));
+                nullify(temp);
+                continue;
+            }
+
+            if(work->shared.slots == NULL || !sharedMapAdd(&work->shared, temp))
+                addToAccount(&work->partials[self->id], temp); //this worker's own table, no locking
+
+            if(list == NULL)
+                list = temp;
+            else
+                tail->next = temp;
+
+            tail = temp;
+            work->chunkKept[chunk]++;
+            temp = (struct row*)malloc(sizeof(struct row));
+
+            if(budgetRows > 0 && ++listRows >= budgetRows)//over our share, the rows so far become a run
+            {
+                if(spillList(&work->chunkRuns[chunk], &list))
+                    listRows = 0;
+                else
+                    budgetRows = 0; //no temp files, go on over the budget
+            }
+        }
+
+        nullify(temp);
+    }
+
+    free(temp);
+    closeInput(stream, work->filename);
+    freeLine(&line);
+
+    /*
+    Our rows now wait for finishJob(), along with those of every other
+    finished chunk of every file. The other half of the budget is theirs,
+    once it is used up we spill instead of waiting in memory.
+    */
+    if(list != NULL && budgetRows > 0 && work->chunkRuns[chunk].count == 0)
+    {
+        if(atomic_fetch_add(&heldRows, listRows) + listRows <= budgetRows * threadCount)
+        {
+            atomic_fetch_add(&work->held, listRows);
+        }
+        else
+        {
+            atomic_fetch_sub(&heldRows, listRows);
+            spillList(&work->chunkRuns[chunk], &list);
+        }
+    }
+    else if(list != NULL && work->chunkRuns[chunk].count > 0)//rest of the rows become our last run
+    {
+        spillList(&work->chunkRuns[chunk], &list);
+    }
+
+    work->chunkHeads[chunk] = sortList(list); //chunks sort in parallel, finishJob() only merges
+    work->chunkFees[chunk] = fees;
+
+    if(atomic_fetch_sub(&work->chunksLeft, 1) == 1)//we were the last chunk of this file
+        finishJob(work);
+
+    return;
+}//END runChunkTask
+
+void finishJob(struct job* work)
+{
+    //Local Variable(s)
+    struct row* list = NULL;
+    struct row* temp;
+    struct row* next;
+    bool spilled = false;
+    int i;
+    int k;
+
+    pthread_mutex_lock(&outputLock);
+
+    strcpy(filename, work->filename);
+    printf("Creating New File for %s...\n", filename);
+
+    for(i = 0; i < work->chunkCount; i++)
+        spilled = spilled || work->chunkRuns[i].count > 0;
+
+    for(i = 0; i < work->chunkCount; i++)//merging in file order keeps equal names in file order
+    {
+        for(k = 0; k < work->chunkRuns[i].count; k++)//runs too, mergeRuns() breaks ties by run
+            addRun(&runs, work->chunkRuns[i].files[k]);
+
+        free(work->chunkRuns[i].files);
+
+        if(spilled && work->chunkHeads[i] != NULL)//once anything is on disk the rest goes there too
+            spillList(&runs, &work->chunkHeads[i]);
+
+        list = mergeLists(list, work->chunkHeads[i]);
+        totalNodes += work->chunkRead[i];
+        keptRows += work->chunkKept[i];
+
+        for(temp = work->chunkFees[i]; temp != NULL; temp = next)
+        {
+            next = temp->next;
+            temp->next = NULL;
+            keepFeeRow(temp);
+        }
+    }
+
+    head = list;
+
+    for(i = 0; i < threadCount; i++)//every worker's totals for this file into one table
+    {
+        mergeAccounts(&accounts, &work->partials[i]);
+        freeAccounts(&work->partials[i]);
+    }
+
+    lastShared = (work->shared.slots != NULL);
+
+    if(lastShared)
+    {
+        sharedMapSnapshot(&work->shared, &accounts);
+        sharedMapFree(&work->shared);
+    }
+
+    if(work->rollups != NULL)
+    {
+        for(i = 0; i < threadCount; i++)//every worker's groups for this file into one table, like the accounts
+            mergeGroups(&rollups, &work->rollups[i]);
+
+        writeRollupFile();
+    }
+
+    if(work->chunkChecks != NULL)
+        writeReconcileReport(filename, work->chunkChecks, work->chunkCount);
+
+    writePayRangeFile();
+    atomic_fetch_sub(&heldRows, atomic_load(&work->held)); //written & freed
+
+    lastChunkCount = work->chunkCount;
+    printf("Completed %s!\n", filename);
+    printStats(&work->columns);//this file's columns, not the last one opened
+    lastChunkCount = 0;
+
+    pthread_mutex_unlock(&outputLock);
+
+    free(work->chunkHeads);
+    free(work->chunkFees);
+    free(work->chunkRuns);
+    free(work->chunkRead);
+    free(work->chunkKept);
+    free(work->chunkChecks);
+    free(work->partials);
+    free(work->rollups);
+    free(work->index.offsets);
+    free(work);
+    return;
+}//END finishJob
+
+long chunkOffset(struct job* work, int chunk)
+{
+    /*
+    Where a chunk starts, chunk == chunkCount is where the last one ends.
+    With an index chunks get the same number of records and start right
+    on one, otherwise the bytes are split evenly and the last chunk reads
+    to EOF.
+    */
+
+    //Local Variable(s)
+    int record;
+
+    if(work->index.count > 0)
+    {
+        record = work->rowFirst + (int)((long long)(work->rowLast - work->rowFirst) * chunk / work->chunkCount);
+        return (record < work->index.count) ? (long)work->index.offsets[record] : work->fileSize;
+    }
+
+    if(chunk == work->chunkCount)
+        return LONG_MAX;
+
+    return work->dataStart + chunk * ((work->fileSize - work->dataStart) / work->chunkCount);
+}//END chunkOffset
+
+void prepareIndex(struct job* work)
+{
+    //Local Variable(s)
+    char* path = concat(work->filename, ".csv.idx");
+
+    if(loadIndex(work->filename, &work->index))
+    {
+        atomic_fetch_add(&indexesReused, 1);
+    }
+    else if(buildIndex(work->filename, work->dataStart, &work->index))
+    {
+        printf("Indexed %s, %d records in %s\n", work->filename, work->index.count, path);
+        atomic_fetch_add(&indexesBuilt, 1);
+    }
+
+    free(path);
+
+    if(work->index.count == 0)//empty, or couldn't be written, split by bytes as usual
+        return;
+
+    work->rowFirst = 0;
+    work->rowLast = work->index.count;
+
+    if(firstRow > 0)
+    {
+        work->rowFirst = (firstRow - 1 < work->index.count) ? firstRow - 1 : work->index.count;
+        work->rowLast = (lastRow < work->index.count) ? lastRow : work->index.count;
+    }
+
+    //same task size as without the index, but never more chunks than records
+    work->chunkCount = 1;
+    work->chunkCount = (int)((chunkOffset(work, 1) - chunkOffset(work, 0)) / CHUNK_BYTES) + 1;
+
+    if(work->chunkCount > work->rowLast - work->rowFirst && work->rowLast > work->rowFirst)
+        work->chunkCount = work->rowLast - work->rowFirst;
+
+    return;
+}//END prepareIndex
+
+unsigned long long sampleHash(FILE* stream, long size)
+{
+    //FNV-1a of the first and last INDEX_SAMPLE bytes, enough to catch an edited or replaced export
+    unsigned char block[INDEX_SAMPLE];
+    unsigned long long hash = 14695981039346656037ULL;
+    size_t count;
+    size_t i;
+    int pass;
+
+    for(pass = 0; pass < 2; pass++)
+    {
+        fseek(stream, (pass == 0 || size <= INDEX_SAMPLE) ? 0 : size - INDEX_SAMPLE, SEEK_SET);
+        count = fread(block, 1, INDEX_SAMPLE, stream);
+
+        for(i = 0; i < count; i++)
+        {
+            hash ^= block[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}//END sampleHash
+
+bool loadIndex(const char* base, struct rowIndex* index)
+{
+    /*
+    A .csv.idx is only used if the CSV still has the size, mtime and
+    sample hash it was built from, anything else and it is rebuilt.
+    */
+
+    //Local Variable(s)
+    char* csvPath = concat(base, ".csv");
+    char* path = concat(base, ".csv.idx");
+    char magic[8];
+    long long header[4]; //size, mtime, hash, count
+    struct stat info;
+    FILE* csv = fopen(csvPath, "rb");
+    FILE* stream = fopen(path, "rb");
+    bool valid = false;
+
+    index->offsets = NULL;
+    index->count = 0;
+
+    if(csv != NULL && stream != NULL && stat(csvPath, &info) == 0
+       && fread(magic, 1, sizeof(magic), stream) == sizeof(magic) && memcmp(magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0
+       && fread(header, sizeof(long long), 4, stream) == 4
+       && header[0] == (long long)info.st_size && header[1] == (long long)info.st_mtime
+       && (unsigned long long)header[2] == sampleHash(csv, info.st_size)
+       && header[3] >= 0 && header[3] <= INT_MAX)
+    {
+        index->offsets = (long long*)malloc((header[3] + 1) * sizeof(long long));
+        index->count = (int)header[3];
+        valid = (fread(index->offsets, sizeof(long long), index->count, stream) == (size_t)index->count);
+    }
+
+    if(!valid)
+    {
+        free(index->offsets);
+        index->offsets = NULL;
+        index->count = 0;
+    }
+
+    if(csv != NULL)
+        fclose(csv);
+
+    if(stream != NULL)
+        fclose(stream);
+
+    free(csvPath);
+    free(path);
+
+    return valid;
+}//END loadIndex
+
+bool buildIndex(const char* base, long dataStart, struct rowIndex* index)
+{
+    /*
+    One pass over the bytes after the headers. A record starts on a line
+    that begins outside of quotes, so the lines inside a multi-line
+    Location are never taken for one. Writes the offsets to the .csv.idx
+    so later runs can skip this.
+    */
+
+    //Local Variable(s)
+    char* csvPath = concat(base, ".csv");
+    char* path = concat(base, ".csv.idx");
+    unsigned char* block = (unsigned char*)malloc(INDEX_BLOCK);
+    long long header[4];
+    long long offset = dataStart;
+    int capacity = 1024;
+    bool inQuotes = false;
+    bool lineStart = true;
+    struct stat info;
+    FILE* csv = fopen(csvPath, "rb");
+    FILE* stream;
+    size_t count;
+    size_t i;
+
+    index->offsets = (long long*)malloc(capacity * sizeof(long long));
+    index->count = 0;
+
+    if(csv == NULL || stat(csvPath, &info) != 0)
+    {
+        free(csvPath);
+        free(path);
+        free(block);
+
+        if(csv != NULL)
+            fclose(csv);
+
+        return false;
+    }
+
+    fseek(csv, dataStart, SEEK_SET);
+
+    while((count = fread(block, 1, INDEX_BLOCK, csv)) > 0)
+    {
+        for(i = 0; i < count; i++, offset++)
+        {
+            if(lineStart && !inQuotes && block[i] != '\n' && block[i] != '\r')//blank lines aren't records
+            {
+                if(index->count == capacity)
+                {
+                    capacity *= 2;
+                    index->offsets = (long long*)realloc(index->offsets, capacity * sizeof(long long));
+                }
+
+                index->offsets[index->count++] = offset;
+            }
+
+            lineStart = (block[i] == '\n');
+
+            if(block[i] == '"')//"" inside a quoted field flips twice, so it needs no special case
+                inQuotes = !inQuotes;
+        }
+    }
+
+    header[0] = (long long)info.st_size;
+    header[1] = (long long)info.st_mtime;
+    header[2] = (long long)sampleHash(csv, info.st_size);
+    header[3] = index->count;
+    fclose(csv);
+
+    stream = fopen(path, "wb");
+
+    if(stream == NULL)
+    {
+        printf("Error: Could not write %s, going on without it.\n", path);
+    }
+    else
+    {
+        fwrite(INDEX_MAGIC "\0\0", 1, 8, stream);
+        fwrite(header, sizeof(long long), 4, stream);
+        fwrite(index->offsets, sizeof(long long), index->count, stream);
+        fclose(stream);
+    }
+
+    free(csvPath);
+    free(path);
+    free(block);
+
+    return true;
+}//END buildIndex
+
+int coreCount()
+{
+    int cores;
+
+#ifdef _WIN32
+    cores = (getenv("NUMBER_OF_PROCESSORS") != NULL) ? atoi(getenv("NUMBER_OF_PROCESSORS")) : 1;
+#else
+    cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    return (cores > 0) ? cores : 1;
+}//END coreCount
+
+bool parsePipeline()
+{
+    //Local Variable(s)
+    pthread_t reader, parser;
+    struct rowBatch* batch;
+    bool inOrder = true;
+    int i;
+
+    ringInit(&lineRing);
+    ringInit(&rowRing);
+    atomic_store(&pipelineStop, false);
+    free(checks.found); //a parse that has to start over checks its rows again
+    memset(&checks, 0, sizeof(struct centBatch));
+
+    if(streaming)
+    {
+        startStream();
+        ringInit(&writeRing);
+        pthread_create(&writerThread, NULL, writerStage, NULL);
+        writerRunning = true;
+    }
+
+    pthread_create(&reader, NULL, readerStage, NULL);
+    pthread_create(&parser, NULL, parserStage, NULL);
+
+    //Aggregate stage runs right here, on the main thread
+    while((batch = (struct rowBatch*)ringPop(&rowRing)) != NULL)
+    {
+        totalNodes += batch->rowsRead;
+
+        for(i = 0; i < batch->count; i++)
+        {
+            if(inOrder && keepRow(batch->rows[i]))
+                continue;
+
+            if(inOrder)//first row out of order, tell the other stages to stop
+            {
+                inOrder = false;
+                atomic_store(&pipelineStop, true);
+            }
+
+            free(batch->rows[i]); //not kept, we are starting over
+        }
+
+        free(batch);
+    }
+
+    pthread_join(reader, NULL);
+    pthread_join(parser, NULL);
+
+    if(!inOrder)
+    {
+        abandonStream();
+        return false;
+    }
+
+    if(streaming)
+        finishStream();
+    else if(runs.count > 0 && head != NULL)
+        spillRun();
+
+    return true;
+}//END parsePipeline
+
+void* readerStage(void* arg)
+{
+    //Local Variable(s)
+    FILE* stream;
+    char str[MAX_CSV_LEN];
+    struct lineBuffer line = { str, MAX_CSV_LEN, 0, false };
+    struct lineBatch* batch = newLineBatch();
+    long start;
+    char* text;
+    long long read;
+
+    (void)arg; //pthread signature, the stage works on the globals
+
+    stream = openInput(filename); //Open File
+    text = readLine(stream, &line); //discard headers
+    read = (text != NULL) ? strlen(text) : 0;
+
+    if(streaming && resumedFrom > read)//skip what the checkpoint already covers, as parsePayRangeFile() does
+    {
+        if(inputCodec(filename) == CODEC_NONE)
+            fseek(stream, resumedFrom, SEEK_SET);
+        else
+            while(resumedFrom > read && (text = readLine(stream, &line)) != NULL)
+                read += strlen(text);
+    }
+
+    freeLine(&line);
+
+    while(!atomic_load(&pipelineStop) && (start = appendLine(stream, &batch->text)) >= 0)
+    {
+        if(strlen(batch->text.text + start) < MAX_STRING_LEN)
+        {
+            batch->text.used = start; //not a data line, same rule parsePayRangeFile() uses
+            continue;
+        }
+
+        batch->starts[batch->count] = start;
+
+        if(++batch->count == BATCH_LINES)
+        {
+            ringPush(&lineRing, batch);
+            batch = newLineBatch();
+        }
+    }
+
+    ringPush(&lineRing, batch); //last, partly filled batch
+    ringPush(&lineRing, NULL); //end of file
+
+    closeInput(stream, filename);
+    return NULL;
+}//END readerStage
+
+struct lineBatch* newLineBatch()
+{
+    //Room for BATCH_LINES ordinary lines up front, the text grows if they run long
+    struct lineBatch* batch = (struct lineBatch*)malloc(sizeof(struct lineBatch));
+
+    batch->count = 0;
+    batch->text.size = BATCH_LINES * MAX_CSV_LEN;
+    batch->text.text = (char*)malloc(batch->text.size);
+    batch->text.used = 0;
+    batch->text.onHeap = true;
+
+    return batch;
+}//END newLineBatch
+
+void* parserStage(void* arg)
+{
+    //Local Variable(s)
+    struct lineBatch* lines;
+    struct rowBatch* batch = (struct rowBatch*)calloc(1, sizeof(struct rowBatch));
+    struct row* temp = (struct row*)malloc(sizeof(struct row));
+    int currCol = 2;
+    int i;
+
+    (void)arg; //pthread signature, the stage works on the globals
+
+    nullify(temp);
+
+    while((lines = (struct lineBatch*)ringPop(&lineRing)) != NULL)
+    {
+        for(i = 0; i < lines->count && !atomic_load(&pipelineStop); i++)
+        {
+            if(!parseLine(lines->text.text + lines->starts[i], temp, &currCol, &columns))
+                continue;
+
+            batch->rowsRead++;
+
+            if(moneyExists(temp))//Only pass rows with money on
+            {
+                convertRow(temp);
+
+                if(reconcileRows)
+                    reconcileRow(&checks, temp);
+
+                batch->rows[batch->count++] = temp;
+                temp = (struct row*)malloc(sizeof(struct row));
+            }
+
+            nullify(temp);
+
+            if(batch->count == BATCH_ROWS)
+            {
+                ringPush(&rowRing, batch);
+                batch = (struct rowBatch*)calloc(1, sizeof(struct rowBatch));
+            }
+        }
+
+        freeLine(&lines->text);
+        free(lines);
+    }
+
+    ringPush(&rowRing, batch);
+    ringPush(&rowRing, NULL);
+
+    free(temp);
+    return NULL;
+}//END parserStage
+
+void* writerStage(void* arg)
+{
+    struct row* account;
+
+    (void)arg; //pthread signature, the stage works on the globals
+
+    while((account = (struct row*)ringPop(&writeRing)) != NULL)
+    {
+        printRows(streamOut, account);
+        fflush(streamOut);
+        freeList(account);
+    }
+
+    return NULL;
+}//END writerStage
+
+void ringInit(struct ring* r)
+{
+    atomic_store(&r->head, 0);
+    atomic_store(&r->tail, 0);
+    atomic_store(&r->sleepers, 0);
+    return;
+}//END ringInit
+
+void ringPush(struct ring* r, void* item)
+{
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    int spins = 0;
+
+    //Full: wait for the consumer to catch up (backpressure)
+    while(tail - atomic_load_explicit(&r->head, memory_order_acquire) == RING_SIZE)
+    {
+        if(spins++ < RING_SPINS)
+            sched_yield();
+        else
+            ringWait(r, &r->head, tail - RING_SIZE);
+    }
+
+    r->slots[tail & (RING_SIZE - 1)] = item;
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release); //publish the slot
+    ringWake(r);
+    return;
+}//END ringPush
+
+void* ringPop(struct ring* r)
+{
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    void* item;
+    int spins = 0;
+
+    //Empty: wait for the producer
+    while(atomic_load_explicit(&r->tail, memory_order_acquire) == head)
+    {
+        if(spins++ < RING_SPINS)
+            sched_yield();
+        else
+            ringWait(r, &r->tail, head);
+    }
+
+    item = r->slots[head & (RING_SIZE - 1)];
+    atomic_store_explicit(&r->head, head + 1, memory_order_release); //give the slot back
+    ringWake(r);
+    return item;
+}//END ringPop
+
+void ringWait(struct ring* r, atomic_size_t* index, size_t stuck)
+{
+    /*
+    Sleeps while *index is still stuck, the stage on the other side is
+    stalled (slow disk, slow decompressor) and spinning would burn a core.
+    sleepers goes up before the last look and ringWake() reads it after
+    publishing, both behind full fences, so one of the two always sees
+    the other and a wakeup can't be lost.
+    */
+    pthread_mutex_lock(&r->lock);
+    atomic_fetch_add(&r->sleepers, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    while(atomic_load_explicit(index, memory_order_acquire) == stuck)
+        pthread_cond_wait(&r->changed, &r->lock);
+
+    atomic_fetch_sub(&r->sleepers, 1);
+    pthread_mutex_unlock(&r->lock);
+    return;
+}//END ringWait
+
+void ringWake(struct ring* r)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if(atomic_load_explicit(&r->sleepers, memory_order_relaxed) > 0)//nobody asleep costs nothing
+    {
+        pthread_mutex_lock(&r->lock);
+        pthread_cond_broadcast(&r->changed);
+        pthread_mutex_unlock(&r->lock);
+    }
+
+    return;
+}//END ringWake
+
+void startStream()
+{
+    char* s = concat(filename, parsedSuffix());
+
+    lastName = 0; //the empty name sorts before everything
+    inputRead = 0;
+    recordStart = 0;
+    lastCheckpoint = 0;
+    resumedFrom = -1;
+    checkpointsWritten = 0;
+    memset(&carried, 0, sizeof(struct accountTotal));
+
+    if(resumeRun && !canCheckpoint())
+        printf("A checkpoint can't carry this run's side reports, starting over.\n");
+
+    if(resumeRun && canCheckpoint() && resumeCheckpoint())//_parsed.csv was cut back to the checkpoint, add on to it
+    {
+        streamOut = fopen(s, "a");
+    }
+    else
+    {
+        streamOut = openOutput(s);
+        printHeaders(streamOut);
+    }
+
+    free(s);
+    return;
+}//END startStream
+
+void flushAccount()
+{
+    if(writerRunning)//the writer stage formats & frees it on its own thread
+    {
+        ringPush(&writeRing, head);
+        head = NULL;
+        tail = NULL;
+        runRows = 0;
+        return;
+    }
+
+    //Rows in the list are one whole account, write them & their total then let them go
+    printRows(streamOut, head);
+    fflush(streamOut); //so whoever is reading the file sees the account right away
+    checkpoint();
+
+    freeList(head);
+    head = NULL;
+    tail = NULL;
+    runRows = 0;
+
+    return;
+}//END flushAccount
+
+void finishStream()
+{
+    if(head != NULL)
+        flushAccount();
+
+    if(writerRunning)//let the writer finish the accounts it still has
+    {
+        ringPush(&writeRing, NULL);
+        pthread_join(writerThread, NULL);
+        writerRunning = false;
+    }
+
+    printTotal(streamOut);
+    closeOutput(streamOut);
+    streamOut = NULL;
+    endCheckpoints(); //finished, nothing to resume
+
+    if(topCount > 0)
+        writeTopReport(filename);
+
+    if(arrowOutput)
+        finishArrow(filename);
+
+    return;
+}//END finishStream
+
+void abandonStream()
+{
+    //Throw away everything streamed so far, the sorted path starts from scratch
+    if(writerRunning)
+    {
+        ringPush(&writeRing, NULL);
+        pthread_join(writerThread, NULL);
+        writerRunning = false;
+    }
+
+    closeOutput(streamOut);
+    streamOut = NULL;
+    endCheckpoints();
+    resumedFrom = -1; //the sorted pass reads the file from the top
+    memset(&carried, 0, sizeof(struct accountTotal));
+
+    freeList(head);
+    head = NULL;
+    tail = NULL;
+    freeList(root);
+    root = NULL;
+    rootTail = NULL;
+    feeOffered = NULL;
+    feeOnlyRows = 0;
+    runRows = 0;
+    keptRows = 0;
+    totalNodes = 0;
+    freeGroups(&rollups);
+    freeAccounts(&accounts);
+
+    //Side reports saw the streamed rows too
+    free(topHeap);
+    topHeap = NULL;
+    topSize = 0;
+    memset(&topPending, 0, sizeof(struct topEntry));
+
+    if(arrowOut != NULL)//reopened (& truncated) once the sorted rows come through
+    {
+        fclose(arrowOut);
+        arrowOut = NULL;
+    }
+    if(arrowRows != NULL)
+        arrowRows->count = 0;
+
+    return;
+}//END abandonStream
+
+bool canCheckpoint()
+{
+    /*
+    Only a plain streamed _parsed.csv can be cut back to a checkpoint and
+    added on to. Compressed output, the writer thread, and the side
+    reports (--reconcile's mismatches too) keep state a checkpoint doesn't
+    cover, so those runs don't take any or resume from one.
+    */
+    return streaming && useCheckpoints && !writerRunning && outputCodec == CODEC_NONE
+           && !arrowOutput && topCount == 0 && groupSetCount == 0 && !reconcileRows;
+}//END canCheckpoint
+
+bool inputIdentity(long long* size, long long* mtime)
+{
+    //Size & mtime of the input, a checkpoint is only good for the file it was taken on
+    struct stat info;
+    char* path = concat(filename, inputExtensions[inputCodec(filename)]);
+    bool found = (stat(path, &info) == 0);
+
+    *size = found ? (long long)info.st_size : -1;
+    *mtime = found ? (long long)info.st_mtime : -1;
+
+    free(path);
+    return found;
+}//END inputIdentity
+
+void checkpoint()
+{
+    /*
+    Called with a whole account just written & flushed. What's kept is
+    already final on disk, so a checkpoint is only a few numbers: where the
+    next record starts, the size of _parsed.csv and the accounts so far
+    added up. The output is synced before the log line that points into
+    it is appended.
+    */
+
+    //Local Variable(s)
+    struct accountTotal* account;
+    struct accountTotal sum = carried;
+    long long size;
+    long long mtime;
+    char* path;
+    int i;
+
+    if(!canCheckpoint() || recordStart - lastCheckpoint < checkpointBytes)
+        return;
+
+    if(checkpointLog == NULL)//first one for this file, start a fresh log
+    {
+        path = concat(filename, ".ckpt");
+        checkpointLog = fopen(path, "w");
+        free(path);
+
+        if(checkpointLog == NULL || !inputIdentity(&size, &mtime))
+        {
+            useCheckpoints = false; //can't keep a log here, don't keep trying
+            return;
+        }
+
+        fprintf(checkpointLog, "%s %lld %lld\n", CHECKPOINT_MAGIC, size, mtime);
+    }
+
+    for(i = 0; i < ACCOUNT_BUCKETS; i++)
+    {
+        for(account = accounts.buckets[i]; account != NULL; account = account->next)
+        {
+            sum.rows += account->rows;
+            sum.mobileCents += account->mobileCents;
+            sum.discountCents += account->discountCents;
+            sum.feeCents += account->feeCents;
+            sum.netCents += account->netCents;
+            sum.totalCents += account->totalCents;
+        }
+    }
+
+    fsync(fileno(streamOut));
+
+    //Fee-only rows are only written at the end, the log keeps them until then
+    logFeeRows(feeLogged != NULL ? feeLogged->next : root);
+    feeLogged = rootTail;
+
+    fprintf(checkpointLog, "%lld %ld %d %d %d %lld %lld %lld %lld %lld %s\n", recordStart, ftell(streamOut), totalNodes, keptRows,
+            sum.rows, sum.mobileCents, sum.discountCents, sum.feeCents, sum.netCents, sum.totalCents, nameText(lastName));
+    fflush(checkpointLog);
+    fsync(fileno(checkpointLog));
+
+    lastCheckpoint = recordStart;
+    checkpointsWritten++;
+
+    return;
+}//END checkpoint
+
+bool resumeCheckpoint()
+{
+    /*
+    Takes the last whole line of <file>.ckpt, one cut short by the crash
+    is ignored. Cuts _parsed.csv back to what that checkpoint had written
+    and sets up the counters & totals, parsePayRangeFile() then skips the
+    input up to its offset. Fee-only rows logged before that checkpoint go
+    back on the root list, the ones after it are read again.
+    */
+
+    //Local Variable(s)
+    char buffer[MAX_CSV_LEN];
+    struct lineBuffer line = { buffer, MAX_CSV_LEN, 0, false };
+    char* path = concat(filename, ".ckpt");
+    char* output = concat(filename, parsedSuffix());
+    char* str;
+    char* last = NULL;
+    struct row* pending = NULL; //fee-only rows not followed by a checkpoint yet
+    struct row* pendingTail = NULL;
+    struct row* temp;
+    char magic[16];
+    long long size;
+    long long mtime;
+    long long loggedSize;
+    long long loggedMtime;
+    long long offset;
+    long outputBytes;
+    int nameAt = 0;
+    bool valid = false;
+    FILE* stream = fopen(path, "r");
+
+    if(stream != NULL && (str = readLine(stream, &line)) != NULL && inputIdentity(&size, &mtime)
+       && sscanf(str, "%15s %lld %lld", magic, &loggedSize, &loggedMtime) == 3
+       && strcmp(magic, CHECKPOINT_MAGIC) == 0 && loggedSize == size && loggedMtime == mtime)
+    {
+        while((str = readLine(stream, &line)) != NULL)
+        {
+            if(str[strlen(str) - 1] != '\n')//cut short by the crash
+                continue;
+
+            if(str[0] == 'F')//a fee-only row, it only counts once a checkpoint follows it
+            {
+                temp = readFeeLine(str);
+
+                if(pending == NULL)
+                    pending = temp;
+                else
+                    pendingTail->next = temp;
+
+                pendingTail = temp;
+                continue;
+            }
+
+            free(last); //a whole checkpoint line, the newest one wins
+            last = strdup(str);
+
+            while(pending != NULL)
+            {
+                temp = pending;
+                pending = pending->next;
+                temp->next = NULL;
+                keepFeeRow(temp);
+            }
+        }
+    }
+
+    if(last != NULL)
+    {
+        valid = (sscanf(last, "%lld %ld %d %d %d %lld %lld %lld %lld %lld %n", &offset, &outputBytes, &totalNodes, &keptRows,
+                        &carried.rows, &carried.mobileCents, &carried.discountCents, &carried.feeCents, &carried.netCents,
+                        &carried.totalCents, &nameAt) >= 10 && nameAt > 0 && truncate(output, outputBytes) == 0);
+    }
+
+    if(valid)
+    {
+        //Start the log over from this checkpoint, a line cut short can't end up in front of the next one
+        checkpointLog = fopen(path, "w");
+
+        if(checkpointLog != NULL)
+        {
+            fprintf(checkpointLog, "%s %lld %lld\n", CHECKPOINT_MAGIC, size, mtime);
+            logFeeRows(root);
+            fputs(last, checkpointLog);
+            fflush(checkpointLog);
+        }
+
+        feeLogged = rootTail;
+
+        lastName = internName(removeNewLine(last + nameAt));
+        resumedFrom = offset;
+        lastCheckpoint = offset;
+        printf("Resuming %s at input byte %lld, %d rows already done...\n", filename, offset, totalNodes);
+    }
+    else
+    {
+        memset(&carried, 0, sizeof(struct accountTotal));
+        totalNodes = 0;
+        keptRows = 0;
+        freeList(root);
+        root = NULL;
+        rootTail = NULL;
+        feeOnlyRows = 0;
+        printf("No usable checkpoint for %s, starting from the beginning...\n", filename);
+    }
+
+    if(stream != NULL)
+        fclose(stream);
+
+    freeLine(&line);
+    freeList(pending);
+    free(last);
+    free(path);
+    free(output);
+
+    return valid;
+}//END resumeCheckpoint
+
+void endCheckpoints()
+{
+    //The file finished (or went to the sorted path), a checkpoint of it would only mislead --resume
+    char* path = concat(filename, ".ckpt");
+
+    if(checkpointLog != NULL)
+    {
+        fclose(checkpointLog);
+        checkpointLog = NULL;
+    }
+
+    feeLogged = NULL;
+    remove(path);
+    free(path);
+
+    return;
+}//END endCheckpoints
+
+void logFeeRows(struct row* temp)
+{
+    //One "F" line per fee-only row, tab separated since names & amounts can hold spaces
+    for(; temp != NULL; temp = temp->next)
+    {
+        fprintf(checkpointLog, "F\t%s\t%s\t%s\t%s\t%s\n", fieldText(&temp->mobileAmt), fieldText(&temp->discountAmt),
+                fieldText(&temp->feeAmt), fieldText(&temp->netAmt), nameText(temp->nameId));
+    }
+
+    return;
+}//END logFeeRows
+
+struct row* readFeeLine(char* str)
+{
+    //Builds the fee-only row back from its "F" line, see logFeeRows()
+
+    //Local Variable(s)
+    struct row* temp = (struct row*)malloc(sizeof(struct row));
+    const char* fields[5];
+    char* token;
+    int i;
+
+    nullify(temp);
+    strtok(removeNewLine(str), "\t"); //the F
+
+    for(i = 0; i < 5; i++)
+    {
+        token = strtok(NULL, "\t");
+        fields[i] = (token != NULL) ? token : "";
+    }
+
+    setField(&temp->mobileAmt, fields[0]);
+    setField(&temp->discountAmt, fields[1]);
+    setField(&temp->feeAmt, fields[2]);
+    setField(&temp->netAmt, fields[3]);
+    temp->nameId = internName(fields[4]);
+    convertRow(temp);
+
+    return temp;
+}//END readFeeLine
+
+void alternativeSort()
+{
+    /*
+    strcmp(s1,s2)
+
+    strcmp returns neg int if stop char in s1 was LESS than in s2 (s1 < s2) s1 stopping char was closer to a than s2
+           returns pos int if stop char in s1 was MORE than in s2 (s1 > s2) s2 stopping char was closer to a then s1
+           returns 0 if equal
+    */
+
+    if(runs.count > 0)//rows were spilled to disk as sorted runs, they get merged while writing
+        return;
+
+    head = sortList(head);
+
+    return;
+}//END alternativeSort
+
+struct row* sortList(struct row* list)
+{
+    /*
+    Merge Sort on the Linked List. Bubble Sort was fine for 500 rows but
+    not for a multi-year dump. Stable, so rows with the same Display Name
+    stay in file order.
+    */
+
+    //Local Variable(s)
+    struct row* slow = list;
+    struct row* fast;
+    struct row* second;
+
+    if(list == NULL || list->next == NULL)//0 or 1 nodes are already sorted
+        return list;
+
+    //find the middle: fast moves two nodes for every one slow moves
+    fast = list->next;
+    while(fast != NULL && fast->next != NULL)
+    {
+        slow = slow->next;
+        fast = fast->next->next;
+    }
+
+    second = slow->next;
+    slow->next = NULL; //cut the list in half
+
+    return mergeLists(sortList(list), sortList(second));
+}//END sortList
+
+struct row* mergeLists(struct row* list, struct row* second)
+{
+    //Local Variable(s)
+    struct row merged; //dummy node, merged.next is the head of the sorted list
+    struct row* tail = &merged;
+
+    while(list != NULL && second != NULL)
+    {
+        if(compareNames(list->nameId, second->nameId) <= 0)//<= keeps the first list first on ties
+        {
+            tail->next = list;
+            list = list->next;
+        }
+        else
+        {
+            tail->next = second;
+            second = second->next;
+        }
+
+        tail = tail->next;
+    }
+
+    tail->next = (list != NULL) ? list : second; //whatever is left is already sorted
+
+    return merged.next;
+}//END mergeLists
+
+void spillRun()
+{
+    //Memory budget reached, the rows so far become a run. writePayRangeFile() k-way merges the runs.
+    if(spillList(&runs, &head))
+        runRows = 0;
+
+    return;
+}//END spillRun
+
+bool spillList(struct runList* into, struct row** list)
+{
+    /*
+    Sorts list, writes it to a temp file as the next run of into and
+    frees it. Without a temp file list is left as it was and we go on
+    over the budget.
+    */
+
+    //Local Variable(s)
+    FILE* stream = tmpfile(); //removed automatically once closed
+    struct row* temp;
+
+    if(stream == NULL)
+    {
+        printf("Error: Could not create a temp file, continuing over the memory budget.\n");
+        return false;
+    }
+
+    *list = sortList(*list);
+
+    for(temp = *list; temp != NULL; temp = temp->next)
+        fwrite(temp, sizeof(struct row), 1, stream);
+
+    rewind(stream);
+    addRun(into, stream);
+
+    freeList(*list);
+    *list = NULL;
+
+    return true;
+}//END spillList
+
+void addRun(struct runList* into, FILE* stream)
+{
+    if(into->count == into->capacity)
+    {
+        into->capacity = (into->capacity == 0) ? 16 : into->capacity * 2;
+        into->files = (FILE**)realloc(into->files, into->capacity * sizeof(FILE*));
+    }
+
+    into->files[into->count++] = stream;
+    return;
+}//END addRun
+
+bool readRunRow(FILE* stream, struct row* temp)
+{
+    if(fread(temp, sizeof(struct row), 1, stream) != 1)
+        return false;
+
+    temp->next = NULL;
+    return true;
+}//END readRunRow
+
+bool readHeadRow(FILE* stream, struct row* temp)
+{
+    //mergeRuns() input for rows a spill couldn't write out, they come off head
+    struct row* next;
+
+    (void)stream;
+
+    if(head == NULL)
+        return false;
+
+    next = head->next;
+    *temp = *head;
+    temp->next = NULL;
+    free(head);
+    head = next;
+
+    return true;
+}//END readHeadRow
+
+void mergeRuns(FILE* stream)
+{
+    //Local Variable(s)
+    struct mergeInput* inputs = (struct mergeInput*)malloc((runs.count + 1) * sizeof(struct mergeInput));
+    int* heap = (int*)malloc((runs.count + 1) * sizeof(int));
+    int heapSize = 0;
+    int i;
+
+    for(i = 0; i < runs.count; i++)
+    {
+        inputs[i].stream = runs.files[i];
+        inputs[i].read = readRunRow;
+
+        if(readRunRow(runs.files[i], &inputs[i].current))
+            heapPush(inputs, heap, &heapSize, i);
+    }
+
+    if(head != NULL)//a last spill failed, those rows are merged from memory, after the runs
+    {
+        head = sortList(head);
+        inputs[i].stream = NULL;
+        inputs[i].read = readHeadRow;
+
+        if(readHeadRow(NULL, &inputs[i].current))
+            heapPush(inputs, heap, &heapSize, i);
+    }
+
+    writeMergedRows(stream, inputs, heap, heapSize, false);
+
+    for(i = 0; i < runs.count; i++)
+        fclose(runs.files[i]);
+
+    free(inputs);
+    free(heap);
+    free(runs.files);
+    runs.files = NULL;
+    runs.capacity = 0; //count stays for the stats
+
+    return;
+}//END mergeRuns
+
+void writePayRangeFile()
+{
+    //Local Variable(s)
+    FILE* stream;
+    struct row* temp = head;  //temp used to avoid loss of head pointer
+    char* s = concat(filename, parsedSuffix());
+
+    sortFeeRows(); //before the listing, topFeeRows() walks them alongside it
+
+    stream = openOutput(s); //Open a new file to write proper data into
+
+    //PRINT HEADERS INTO FILE
+    printHeaders(stream);
+
+    if(runs.count > 0)//sorted runs on disk, merge them as we write
+        mergeRuns(stream);
+    else if(head != NULL)
+        printRows(stream, temp);
+
+    printTotal(stream);
+
+    closeOutput(stream);
+
+    if(topCount > 0)
+        writeTopReport(filename);
+
+    if(arrowOutput)
+        finishArrow(filename);
+
+    freeList(head);
+    head = NULL;
+    free(s);
+    return;
+
+}//END writePayRangeFile
+
+void printHeaders(FILE* stream)
+{
+    if(outputFormat == FORMAT_NDJSON)//every object names its own fields
+        return;
+
+    fprintf(stream, "Display Name,");
+    fprintf(stream, "Mobile,");
+    fprintf(stream, "Discounts,");
+    fprintf(stream, "Fee,");
+    fprintf(stream, "Net,");
+    fprintf(stream, "Total\n");
+    return;
+}//END printHeaders
+
+void printRows(FILE* stream, struct row* temp)
+{
+    int flag = NOTVERIFIED;   //flag for end of list
+    long long totalAmt = 0;   //used to store total amounts between nodes of the same account, in cents
+
+    if(outputFormat == FORMAT_NDJSON)
+    {
+        printRowsJson(stream, temp);
+        return;
+    }
+
+    while(flag == NOTVERIFIED)
+    {
+        csvString(stream, nameText(temp->nameId), strlen(nameText(temp->nameId))); fprintf(stream, ",");//Write Display Name & Comma
+        fputs(fieldText(&temp->mobileAmt), stream); fprintf(stream, ",");//Write Mobile Amt & Comma
+        fputs(fieldText(&temp->discountAmt), stream);fprintf(stream, ",");//Write Discount Amt & Comma
+        fputs(fieldText(&temp->feeAmt), stream); fprintf(stream, ",");//Write Fee Amt & Comma
+        fputs(fieldText(&temp->netAmt), stream); fprintf(stream, ",");//Write Net Amt & Comma
+
+        topFeeRows(temp->nameId, false);
+        topRow(temp->nameId, temp->mobileCents, temp->discountCents, temp->feeCents, temp->netCents);
+        arrowRow(temp->nameId, temp->mobileCents, temp->discountCents, temp->feeCents, temp->netCents);
+
+        if(temp->next != NULL)//If there are still more items to come &
+        {
+            if(isNextMatch(temp->nameId,temp->next->nameId))//CurrName & NextName Match, don't write total
+            {
+                fprintf(stream, "\n");
+                totalAmt += temp->totalCents;
+            }
+            else//not a match, write total
+            {
+                totalAmt += temp->totalCents;
+                printCents(stream, totalAmt); fprintf(stream, "\n");
+                totalAmt = 0;
+            }
+        }
+        else//at last node, write total
+        {
+            totalAmt += temp->totalCents;
+            printCents(stream, totalAmt); fprintf(stream, "\n");
+        }
+
+
+        if(temp->next == NULL)
+            flag = VERIFIED; //We're at the end of list, using temp so we dont use head of list location
+        else
+            temp = temp->next; //move to next row
+    }
+
+    return;
+}//END printRows
+
+const char* parsedSuffix()
+{
+    return (outputFormat == FORMAT_NDJSON) ? "_parsed.ndjson" : "_parsed.csv";
+}//END parsedSuffix
+
+void printRowsJson(FILE* stream, struct row* temp)
+{
+    //Same walk as printRows(), the account object follows its last machine
+    for(; temp != NULL; temp = temp->next)
+    {
+        topFeeRows(temp->nameId, false);
+        topRow(temp->nameId, temp->mobileCents, temp->discountCents, temp->feeCents, temp->netCents);
+        arrowRow(temp->nameId, temp->mobileCents, temp->discountCents, temp->feeCents, temp->netCents);
+        jsonRow(stream, temp->nameId, temp->mobileCents, temp->discountCents, temp->feeCents, temp->netCents);
+
+        if(temp->next == NULL || !isNextMatch(temp->nameId, temp->next->nameId))
+            jsonAccount(stream);
+    }
+
+    return;
+}//END printRowsJson
+
+void jsonRow(FILE* stream, unsigned nameId, long long mobile, long long discount, long long fee, long long net)
+{
+    //Local Variable(s)
+    const char* name = nameText(nameId);
+    const char* account = nameText(nameEntry(nameId)->accountId);
+
+    fprintf(stream, "{\"type\":\"machine\",\"name\":");
+    jsonString(stream, name, strlen(name));
+    fprintf(stream, ",\"account\":");
+    jsonString(stream, account, accountLength(account));
+    fprintf(stream, ",\"mobileCents\":%lld,\"discountCents\":%lld,\"feeCents\":%lld,\"netCents\":%lld,\"totalCents\":%lld}\n",
+            mobile, discount, fee, net, rowTotal(mobile, discount, fee));
+
+    jsonPending.nameId = nameEntry(nameId)->accountId;
+    jsonPending.rows++;
+    jsonPending.mobileCents += mobile;
+    jsonPending.discountCents += discount;
+    jsonPending.feeCents += fee;
+    jsonPending.netCents += net;
+    jsonPending.totalCents += rowTotal(mobile, discount, fee);
+
+    return;
+}//END jsonRow
+
+void jsonAccount(FILE* stream)
+{
+    const char* account = nameText(jsonPending.nameId);
+
+    fprintf(stream, "{\"type\":\"account\",\"account\":");
+    jsonString(stream, account, accountLength(account));
+    fprintf(stream, ",\"machines\":%d,\"mobileCents\":%lld,\"discountCents\":%lld,\"feeCents\":%lld,\"netCents\":%lld,\"totalCents\":%lld}\n",
+            jsonPending.rows, jsonPending.mobileCents, jsonPending.discountCents, jsonPending.feeCents,
+            jsonPending.netCents, jsonPending.totalCents);
+
+    memset(&jsonPending, 0, sizeof(struct topEntry));
+    return;
+}//END jsonAccount
+
+void jsonString(FILE* stream, const char* str, int length)
+{
+    /*
+    Writes str quoted & escaped. Names hardly ever need escaping, so the
+    bytes are checked 8 at a time (SWAR) and clean runs go out in one
+    fwrite; only a word holding a '"', '\\' or control char is looked at
+    byte by byte. UTF-8 (high bit set) is valid JSON as is.
+    */
+
+    //Local Variable(s)
+    const unsigned long long ones = 0x0101010101010101ULL;
+    const unsigned long long highs = 0x8080808080808080ULL;
+    unsigned long long word, quote, slash;
+    int start = 0; //first byte not written yet
+    int i = 0;
+    int end;
+
+    fputc('"', stream);
+
+    while(i < length)
+    {
+        if(i + 8 <= length)
+        {
+            memcpy(&word, str + i, 8);
+            quote = word ^ (ones * '"');
+            slash = word ^ (ones * '\\');
+
+            //a byte is flagged if it is below 0x20 or 0 after the xor, i.e. '"' or '\\'
+            if((((word - ones * 0x20) | (quote - ones) | (slash - ones)) & ~word & highs) == 0)
+            {
+                i += 8;
+                continue;
+            }
+
+            end = i + 8;
+        }
+        else
+        {
+            end = length; //tail shorter than a word
+        }
+
+        for(; i < end; i++)
+        {
+            unsigned char c = str[i];
+
+            if(c >= 0x20 && c != '"' && c != '\\')
+                continue;
+
+            fwrite(str + start, 1, i - start, stream);
+            start = i + 1;
+
+            if(c == '"' || c == '\\')
+                fprintf(stream, "\\%c", c);
+            else if(c == '\n')
+                fprintf(stream, "\\n");
+            else if(c == '\r')
+                fprintf(stream, "\\r");
+            else if(c == '\t')
+                fprintf(stream, "\\t");
+            else
+                fprintf(stream, "\\u%04x", c);
+        }
+    }
+
+    fwrite(str + start, 1, length - start, stream);
+    fputc('"', stream);
+    return;
+}//END jsonString
+
+void csvString(FILE* stream, const char* str, int length)
+{
+    /*
+    Writes str as one CSV column. A name holding a comma, a quote or a
+    line break is quoted with its quotes doubled, so readParsedRow() (or
+    a spreadsheet) reads it back whole. Any other name goes out as is.
+    */
+
+    //Local Variable(s)
+    int start = 0; //first byte not written yet
+    int i;
+
+    for(i = 0; i < length && str[i] != ',' && str[i] != '"' && str[i] != '\n' && str[i] != '\r'; i++)
+        ; //look for anything that needs quoting
+
+    if(i == length)
+    {
+        fwrite(str, 1, length, stream);
+        return;
+    }
+
+    fputc('"', stream);
+
+    for(i = 0; i < length; i++)
+    {
+        if(str[i] == '"')//write up to & including the quote, then start over at it so it goes out twice
+        {
+            fwrite(str + start, 1, i + 1 - start, stream);
+            start = i;
+        }
+    }
+
+    fwrite(str + start, 1, length - start, stream);
+    fputc('"', stream);
+    return;
+}//END csvString
+
+void printTotal(FILE* stream)
+{
+    /*
+    Fee-only rows (no Mobile or Discounts, only a Fee) get their own
+    section between the rows & the totals. Their Total is Mobile minus
+    Discounts minus the Fee, so minus the Fee, in every format. The Totals
+    line counts them too, its Total stays Mobile minus Discounts like
+    every account's.
+    */
+
+    //Local Variable(s)
+    struct row* temp;
+    struct accountTotal* account;
+    long long mobile = 0, discount = 0, fee = 0, net = 0, total = 0;
+    long long feeMobile = 0, feeDiscount = 0, feeOnly = 0, feeNet = 0, feeTotal = 0; //fee-only rows added up
+    int rows = 0;
+    int feeRows = 0;
+    int i;
+
+    topFeeRows(0, true); //the ones after the last row of the listing
+    sortFeeRows();
+
+    for(temp = root; temp != NULL; temp = temp->next)
+    {
+        feeRows++;
+        feeMobile += temp->mobileCents;
+        feeDiscount += temp->discountCents;
+        feeOnly += temp->feeCents;
+        feeNet += temp->netCents;
+        feeTotal += temp->totalCents;
+    }
+
+    if(outputFormat == FORMAT_CSV && root != NULL)
+    {
+        fprintf(stream, "\n");
+        fprintf(stream, "\n");
+        fprintf(stream, FEE_SECTION "\n");
+    }
+
+    for(temp = root; temp != NULL; temp = temp->next)
+    {
+        arrowRow(temp->nameId, temp->mobileCents, temp->discountCents, temp->feeCents, temp->netCents);
+
+        if(outputFormat == FORMAT_NDJSON)
+        {
+            fprintf(stream, "{\"type\":\"feeOnly\",\"name\":");
+            jsonString(stream, nameText(temp->nameId), strlen(nameText(temp->nameId)));
+            fprintf(stream, ",\"feeCents\":%lld,\"netCents\":%lld,\"totalCents\":%lld}\n",
+                    temp->feeCents, temp->netCents, temp->totalCents);
+            continue;
+        }
+
+        csvString(stream, nameText(temp->nameId), strlen(nameText(temp->nameId))); fprintf(stream, ",");//Write Display Name & Comma
+        printCents(stream, temp->mobileCents); fprintf(stream, ",");//Written from the cents, a --merge adds weeks into them
+        printCents(stream, temp->discountCents); fprintf(stream, ",");
+        printCents(stream, temp->feeCents); fprintf(stream, ",");
+        printCents(stream, temp->netCents); fprintf(stream, ",");
+        printCents(stream, temp->totalCents); fprintf(stream, "\n");
+    }
+
+    if(outputFormat == FORMAT_CSV && root != NULL)
+    {
+        fprintf(stream, FEE_TOTALS ",");
+        printCents(stream, feeMobile); fprintf(stream, ",");
+        printCents(stream, feeDiscount); fprintf(stream, ",");
+        printCents(stream, feeOnly); fprintf(stream, ",");
+        printCents(stream, feeNet); fprintf(stream, ",");
+        printCents(stream, feeTotal); fprintf(stream, "\n");
+    }
+
+    freeList(root);
+    root = NULL;
+    rootTail = NULL;
+    feeLogged = NULL;
+    feeOffered = NULL;
+
+    //Accounts from before a --resume only come back as their sum
+    rows = carried.rows;
+    mobile = carried.mobileCents;
+    discount = carried.discountCents;
+    fee = carried.feeCents;
+    net = carried.netCents;
+    total = carried.totalCents;
+    memset(&carried, 0, sizeof(struct accountTotal));
+
+    //Fee-only rows aren't in any account
+    rows += feeRows;
+    mobile += feeMobile;
+    discount += feeDiscount;
+    fee += feeOnly;
+    net += feeNet;
+
+    //Add up the merged account totals, whole cents so the order doesn't matter
+    for(i = 0; i < ACCOUNT_BUCKETS; i++)
+    {
+        for(account = accounts.buckets[i]; account != NULL; account = account->next)
+        {
+            rows += account->rows;
+            mobile += account->mobileCents;
+            discount += account->discountCents;
+            fee += account->feeCents;
+            net += account->netCents;
+            total += account->totalCents;
+        }
+    }
+
+    if(outputFormat == FORMAT_NDJSON)
+    {
+        fprintf(stream, "{\"type\":\"totals\",\"machines\":%d,\"mobileCents\":%lld,\"discountCents\":%lld,"
+                        "\"feeCents\":%lld,\"netCents\":%lld,\"totalCents\":%lld}\n", rows, mobile, discount, fee, net, total);
+        freeAccounts(&accounts);
+        return;
+    }
+
+    fprintf(stream, "\n");
+    fprintf(stream, "\n");
+    fprintf(stream, "Totals:,");
+    printCents(stream, mobile); fprintf(stream, ",");
+    printCents(stream, discount); fprintf(stream, ",");
+    printCents(stream, fee); fprintf(stream, ",");
+    printCents(stream, net); fprintf(stream, ",");
+    printCents(stream, total); fprintf(stream, "\n");
+
+    freeAccounts(&accounts); //file is done
+    return;
+
+}//END printTotal
+
+void freeList(struct row* node)
+{
+    struct row* temp;
+
+    while(node != NULL)//while there are nodes remaining to free
+    {
+        temp = node->next;//move temp to next node over
+        free(node);//free curr node
+        node = temp;//set root to next node
+    }
+
+    return;
+}
+
+float strToFloat(char mobileAmt[MAX_STRING_LEN],char discountAmt[MAX_STRING_LEN])
+{
+    float net = 0.00;
+    float amt;
+    int i;
+    int length = strlen(mobileAmt);
+
+    /*
+        mobileAmt in form:   '$0.00'
+        discountAmt in form: '$0.00'
+    */
+
+    //Determine where the '.' is:
+    for(i = 0; i < length; i++)//loop through string
+    {
+        if(mobileAmt[i] == '.')//once we find our decimal marker
+        {
+            //Get & Add Hundredths Place
+            amt = mobileAmt[i+2] - '0';
+            net += 0.01*amt;
+
+            //Get & Add Tenths Place
+            amt = mobileAmt[i+1] - '0';
+            net += 0.1*amt;
+
+            //Get & Add Ones Place
+            amt = mobileAmt[i-1] - '0';
+            net += 1.0*amt;
+
+            if(i == 3)
+            {
+                //Get & Add Tens Place IF IT EXISTS
+                amt = mobileAmt[i-2] - '0';
+                net += 10.0*amt;
+            }
+
+            if(i == 4)
+            {
+                //Get & Add Hundreds Place IF IT EXISTS
+                amt = mobileAmt[i-3] - '0';
+                net += 100.0*amt;
+            }
+        }
+    }
+
+    //Repeat same process for discountAmt
+    length = strlen(discountAmt);
+
+    //Determine where the '.' is:
+    for(i = 0; i < length; i++)//loop through string
+    {
+        if(discountAmt[i] == '.')//once we find our decimal marker
+        {
+            //Get & Sub Hundredths Place
+            amt = discountAmt[i+2] - '0';
+            net -= 0.01*amt;
+
+            //Get & Sub Tenths Place
+            amt = discountAmt[i+1] - '0';
+            net -= 0.1*amt;
+
+            //Get & Sub Ones Place
+            amt = discountAmt[i-1] - '0';
+            net -= 1.0*amt;
+
+            if(i == 3)
+            {
+                //Get & Sub Tens Place IF IT EXISTS
+                amt = discountAmt[i-2] - '0';
+                net -= 10.0*amt;
+            }
+
+            if(i == 4)
+            {
+                //Get & Sub Hundreds Place IF IT EXISTS
+                amt = discountAmt[i-3] - '0';
+                net -= 100.0*amt;
+            }
+        }
+    }
+
+    return net;
+}//END strToInt
+
+char* removeNewLine(char netAmt[MAX_STRING_LEN])
+{
+    char* pos;
+
+    if((pos=strchr(netAmt, '\n')) != NULL)//Case 1: Has NewLineChar, must remove it
+    {
+         *pos = '\0';
+         return netAmt;
+    }
+    else//Case 2: Has no newline char
+    {
+        return netAmt;
+    }
+}//END removeNewLine
+
+void mergeParsedFiles(char** files, int fileCount)
+{
+    /*
+    Each _parsed.csv is already sorted by Display Name, so a period report
+    only needs a k-way merge: keep one row per file in a min-heap and
+    always write the smallest. Memory stays at one row per file and the
+    cost is about the size of the inputs, no re-sort needed.
+    */
+
+    //Local Variable(s)
+    struct mergeInput* inputs = (struct mergeInput*)calloc(2 * fileCount, sizeof(struct mergeInput)); //rows & fee-only rows of each file
+    int* heap = (int*)malloc(2 * fileCount * sizeof(int));
+    int heapSize = 0;
+    char str[MAX_CSV_LEN];
+    struct lineBuffer line = { str, MAX_CSV_LEN, 0, false };
+    FILE* stream;
+    int i;
+
+    for(i = 0; i < fileCount; i++)
+    {
+        inputs[2 * i].stream = openParsed(files[i]);
+
+        if(inputs[2 * i].stream == NULL)
+        {
+            printf("Error: Could not open %s, leaving it out of the merge.\n", files[i]);
+            continue;
+        }
+
+        readLine(inputs[2 * i].stream, &line); //discard headers
+
+        inputs[2 * i].read = readParsedRow;
+
+        if(readParsedRow(inputs[2 * i].stream, &inputs[2 * i].current))
+            heapPush(inputs, heap, &heapSize, 2 * i);
+
+        /*
+        The fee-only rows are sorted too, just in their own section. A
+        second pass over the file merges them in as one more input, so the
+        same machine still adds up across weeks.
+        */
+        inputs[2 * i + 1].stream = openParsed(files[i]);
+        inputs[2 * i + 1].read = readParsedRow;
+
+        if(inputs[2 * i + 1].stream != NULL && findFeeSection(inputs[2 * i + 1].stream)
+           && readParsedRow(inputs[2 * i + 1].stream, &inputs[2 * i + 1].current))
+            heapPush(inputs, heap, &heapSize, 2 * i + 1);
+    }
+
+    freeLine(&line);
+
+    printf("Merging %d Files Now...\n", fileCount);
+
+    strncpy(filename, mergeOutput, MAX_STRING_LEN - 1); //side reports go next to the period report
+    filename[MAX_STRING_LEN - 1] = '\0';
+    stripExtension(filename);
+
+    stream = openOutput(mergeOutput);
+    printHeaders(stream);
+    writeMergedRows(stream, inputs, heap, heapSize, true);
+    printTotal(stream); //accounts & fee-only rows were added up as they were merged
+    closeOutput(stream);
+
+    if(topCount > 0)
+        writeTopReport(filename);
+
+    if(arrowOutput)
+        finishArrow(filename);
+
+    for(i = 0; i < 2 * fileCount; i++)
+    {
+        if(inputs[i].stream != NULL)
+        {
+            if(pathCodec(files[i / 2]) == CODEC_NONE)
+                fclose(inputs[i].stream);
+            else if(!closePipe(inputs[i].stream, decompressors[pathCodec(files[i / 2])], files[i / 2])
+                    && i % 2 == 0 && inputs[i + 1].stream != NULL)
+            {
+                pclose(inputs[i + 1].stream); //same file's fee-only pass, one error is enough
+                inputs[i + 1].stream = NULL;
+            }
+        }
+    }
+
+    free(inputs);
+    free(heap);
+
+    printf("Completed! Period report written to %s\n", mergeOutput);
+    return;
+}//END mergeParsedFiles
+
+FILE* openParsed(const char* path)
+{
+    //A _parsed.csv to merge, a --compress'd week is read through its decompressor
+    if(pathCodec(path) == CODEC_NONE)
+        return fopen(path, "r");
+
+    return openPipe(decompressors[pathCodec(path)], "", path, "r");
+}//END openParsed
+
+bool findFeeSection(FILE* stream)
+{
+    //Skips to the first fee-only row, false if the file has none (or was written before they had a section)
+    char buffer[MAX_CSV_LEN];
+    struct lineBuffer line = { buffer, MAX_CSV_LEN, 0, false };
+    char* str;
+    bool found = false;
+
+    while(!found && (str = readLine(stream, &line)) != NULL)
+    {
+        str[strcspn(str, "\r\n")] = '\0';
+        found = (strcmp(str, FEE_SECTION) == 0);
+    }
+
+    freeLine(&line);
+    return found;
+}//END findFeeSection
+
+void writeMergedRows(FILE* stream, struct mergeInput* inputs, int* heap, int heapSize, bool combineNames)
+{
+    /*
+    combineNames: the same machine coming from several inputs (weeks) is
+    added into one row. Without it every row is written as it was read,
+    which is what the spilled runs of a single file need.
+    */
+
+    //Local Variable(s)
+    struct row temp; //row being built, the same machine from every week is added into it
+    struct row sum; //temp with the weeks' cents, what the totals & the fee section get
+    struct row* temp2;
+    long long mobile = 0, discount = 0, fee = 0, net = 0;
+    long long totalAmt = 0; //account total, kept in cents so weeks add up exactly
+    bool ended; //temp is the last machine of its account
+    bool open = false; //a machine was written but its line not ended yet
+    int i;
+
+    while(heapSize > 0)
+    {
+        i = heapPop(inputs, heap, &heapSize);
+        temp = inputs[i].current;
+
+        mobile += strToCents(fieldText(&temp.mobileAmt));
+        discount += strToCents(fieldText(&temp.discountAmt));
+        fee += strToCents(fieldText(&temp.feeAmt));
+        net += strToCents(fieldText(&temp.netAmt));
+
+        if(inputs[i].read(inputs[i].stream, &inputs[i].current))//refill from the file we just took from
+            heapPush(inputs, heap, &heapSize, i);
+
+        if(combineNames && heapSize > 0 && temp.nameId == inputs[heap[0]].current.nameId)
+            continue; //same machine in another week, keep adding before writing it
+
+        ended = (heapSize == 0 || !isNextMatch(temp.nameId, inputs[heap[0]].current.nameId)); //last machine of the account
+
+        if(combineNames)//nothing added these up while parsing, do it here for printTotal()
+        {
+            sum = temp;
+            sum.next = NULL;
+            sum.mobileCents = mobile;
+            sum.discountCents = discount;
+            sum.feeCents = fee;
+            sum.netCents = net;
+            sum.totalCents = rowTotal(mobile, discount, fee);
+            mobile = discount = fee = net = 0;
+
+            if(isFeeOnly(&sum))//a fee-only machine for the whole period, it goes in the fee section
+            {
+                temp2 = (struct row*)malloc(sizeof(struct row));
+                *temp2 = sum;
+                keepFeeRow(temp2);
+                topFeeRows(temp2->nameId, false); //merged in name order already, top can have it now
+
+                if(ended && open)//it was the last machine of an account already started, close that
+                {
+                    printCents(stream, totalAmt); fprintf(stream, "\n");
+                    totalAmt = 0;
+                    open = false;
+                }
+
+                if(ended && outputFormat == FORMAT_NDJSON && jsonPending.rows > 0)
+                    jsonAccount(stream);
+                continue;
+            }
+
+            addToAccount(&accounts, &sum);
+            mobile = sum.mobileCents;
+            discount = sum.discountCents;
+            fee = sum.feeCents;
+            net = sum.netCents;
+        }
+
+        topFeeRows(temp.nameId, false);
+        topRow(temp.nameId, mobile, discount, fee, net);
+        arrowRow(temp.nameId, mobile, discount, fee, net);
+
+        if(outputFormat == FORMAT_NDJSON)
+        {
+            jsonRow(stream, temp.nameId, mobile, discount, fee, net);
+            mobile = discount = fee = net = 0;
+
+            if(ended)
+                jsonAccount(stream);
+            continue;
+        }
+
+        if(open)//the machine before this one is in the same account, no total on it
+            fprintf(stream, "\n");
+
+        csvString(stream, nameText(temp.nameId), strlen(nameText(temp.nameId))); fprintf(stream, ",");
+
+        if(combineNames)
+        {
+            printCents(stream, mobile); fprintf(stream, ",");
+            printCents(stream, discount); fprintf(stream, ",");
+            printCents(stream, fee); fprintf(stream, ",");
+            printCents(stream, net); fprintf(stream, ",");
+        }
+        else
+        {
+            fputs(fieldText(&temp.mobileAmt), stream); fprintf(stream, ",");
+            fputs(fieldText(&temp.discountAmt), stream); fprintf(stream, ",");
+            fputs(fieldText(&temp.feeAmt), stream); fprintf(stream, ",");
+            fputs(fieldText(&temp.netAmt), stream); fprintf(stream, ",");
+        }
+
+        totalAmt += rowTotal(mobile, discount, fee);
+        mobile = discount = fee = net = 0;
+        open = !ended; //the line ends once we know whether another machine of the account follows
+
+        if(ended)//last machine of the account, write total
+        {
+            printCents(stream, totalAmt); fprintf(stream, "\n");
+            totalAmt = 0;
+        }
+    }
+
+    return;
+}//END writeMergedRows
+
+bool readParsedRow(FILE* stream, struct row* temp)
+{
+    //Local Variable(s)
+    char buffer[MAX_CSV_LEN];
+    struct lineBuffer line = { buffer, MAX_CSV_LEN, 0, false };
+    char *str = readLine(stream, &line);
+    char *cursor;
+    char *token;
+    char *pos;
+    bool open;
+    int col = 1;
+
+    //Rows end at the blank line printTotal() puts before the totals, fee-only rows at their own totals
+    if(str == NULL || str[0] == '\n' || str[0] == '\r' || strncmp(str, FEE_TOTALS, strlen(FEE_TOTALS)) == 0)
+    {
+        freeLine(&line);
+        return false;
+    }
+
+    //A quoted Display Name with a line break in it goes on over the next line, see csvString()
+    for(;;)
+    {
+        open = false;
+
+        for(pos = line.text; *pos != '\0'; pos++)
+            open ^= (*pos == '"'); //a doubled quote flips it back
+
+        if(!open)
+            break;
+
+        line.used--; //the next line goes over the terminator
+
+        if(appendLine(stream, &line) < 0)//file ends inside the quote, take what there is
+        {
+            line.text[line.used++] = '\0';
+            break;
+        }
+    }
+
+    str = line.text;
+    pos = str + strlen(str);
+
+    if(pos > str && pos[-1] == '\n')//only the one ending the row, a quoted name can hold others
+        pos[-1] = '\0';
+
+    nullify(temp);
+    cursor = str;
+
+    while(col <= 5 && (token = nextQuoted(&cursor, comma[0])) != NULL)
+    {
+        if(col == 1)
+            temp->nameId = internName(token);
+        else if(col == 2)
+            setField(&temp->mobileAmt, token);
+        else if(col == 3)
+            setField(&temp->discountAmt, token);
+        else if(col == 4)
+            setField(&temp->feeAmt, token);
+        else
+            setField(&temp->netAmt, token);
+
+        col++;
+    }
+
+    freeLine(&line);
+    return true;
+}//END readParsedRow
+
+bool mergeLess(struct mergeInput* inputs, int a, int b)
+{
+    int cmp = compareNames(inputs[a].current.nameId, inputs[b].current.nameId);
+
+    if(cmp != 0)
+        return cmp < 0;
+
+    return a < b; //same name, earlier file first so the merge is stable
+}//END mergeLess
+
+void heapPush(struct mergeInput* inputs, int* heap, int* heapSize, int input)
+{
+    int i = (*heapSize)++;
+    int parent;
+
+    //sift up until our parent is smaller than us
+    while(i > 0)
+    {
+        parent = (i - 1) / 2;
+
+        if(!mergeLess(inputs, input, heap[parent]))
+            break;
+
+        heap[i] = heap[parent];
+        i = parent;
+    }
+
+    heap[i] = input;
+    return;
+}//END heapPush
+
+int heapPop(struct mergeInput* inputs, int* heap, int* heapSize)
+{
+    int top = heap[0];
+    int last = heap[--(*heapSize)];
+    int i = 0;
+    int child;
+
+    //sift the last entry down from the top
+    while((child = (2 * i) + 1) < *heapSize)
+    {
+        if(child + 1 < *heapSize && mergeLess(inputs, heap[child + 1], heap[child]))
+            child++;
+
+        if(!mergeLess(inputs, heap[child], last))
+            break;
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = last;
+    return top;
+}//END heapPop
+
+void printStats(const struct columnMap* map)
+{
+    printf("\nStats:\n");
+    printf("    Rows Read:      %d\n", totalNodes);
+    printf("    Rows Kept:      %d\n", keptRows);
+    printf("    Mode:           %s\n", streaming ? "Streamed" : "Sorted");
+    printf("    Order:          %s\n", humanOrder ? "human (--collate human)" : "binary");
+
+    if(map->totalColumns > 0)
+        printf("    Parser:         %s\n", map->knownParser != NULL ? "fixed PayRange layout" : "column plan");
+
+    if(map->totalColumns > 0 && (map->delim != ',' || map->crlf || map->bom || map->quoted))
+        printf("    Dialect:        %s%s%s%s\n", map->delim == ',' ? "comma" : (map->delim == ';' ? "semicolon" : "tab"),
+               map->crlf ? ", CRLF" : "", map->bom ? ", BOM" : "", map->quoted ? ", quoted fields" : "");
+
+    if(map->unknownColumns > 0)
+        printf("    Unknown Columns: %d, skipped (first: \"%s\")\n", map->unknownColumns, map->firstUnknown);
+
+    if(inputCodec(filename) != CODEC_NONE)
+        printf("    Input:          %s, read through '%s'\n", inputExtensions[inputCodec(filename)], decompressors[inputCodec(filename)]);
+
+    if(resumedFrom >= 0)
+        printf("    Checkpoints:    %d written, resumed at input byte %lld\n", checkpointsWritten, resumedFrom);
+    else if(checkpointsWritten > 0)
+        printf("    Checkpoints:    %d written (.ckpt, removed when done)\n", checkpointsWritten);
+
+    if(feeOnlyRows > 0)
+        printf("    Fee Only:       %d row(s), listed after the rows with their own totals\n", feeOnlyRows);
+
+    if(reconcileRows)
+        printf("    Reconcile:      %lld rows checked, %d with Net != Mobile - Fee - Discounts (_reconcile.csv)\n", reconcileChecked, reconcileMismatched);
+
+    if(useIndex)
+        printf("    Index:          %d reused, %d built (.csv.idx)%s\n", atomic_load(&indexesReused), atomic_load(&indexesBuilt), firstRow > 0 ? ", --rows" : "");
+
+    if(outputCodec != CODEC_NONE)
+        printf("    Output:         compressed, files end in %s\n", outputExtensions[outputCodec]);
+
+    if(outputFormat == FORMAT_NDJSON)
+        printf("    Format:         ndjson (%s%s)\n", filename, parsedSuffix());
+
+    if(usePipeline)
+        printf("    Pipeline:       read | parse | aggregate%s\n", streaming ? " | write" : "");
+
+    if(memoryBudget > 0 && streaming)//only one account is ever held, there is nothing to spill
+        printf("    Memory Budget:  %lld MB, not needed streaming\n", memoryBudget / (1024 * 1024));
+    else if(memoryBudget > 0)
+        printf("    Memory Budget:  %lld MB\n", memoryBudget / (1024 * 1024));
+    else
+        printf("    Memory Budget:  None\n");
+
+    printf("    Sorted Runs:    %d spilled to disk\n", runs.count);
+
+    if(lastChunkCount > 0)
+    {
+        printf("    Parse Tasks:    %d chunk(s) over %d worker(s)\n", lastChunkCount, threadCount);
+        printf("    Account Totals: %s\n", lastShared ? "shared lock-free map" : "per-worker tables");
+    }
+    printf("\n");
+
+    totalNodes = 0;
+    keptRows = 0;
+    runs.count = 0;
+    reconcileChecked = 0;
+    reconcileMismatched = 0;
+    feeOnlyRows = 0;
+    return;
+}//END printStats
+
+long long strToCents(const char* amt)
+{
+    long long cents = 0;
+    int decimals = -1; //digits seen after the '.', -1 until we find it
+    bool negative = false;
+
+    /*
+        amt in form: '$0.00', '-$0.16' or '$1,250.00'
+        Anything that is not a digit, '-' or '.' ($ and , included) is skipped
+    */
+    for(; *amt != '\0'; amt++)
+    {
+        if(*amt == '-')
+            negative = true;
+        else if(*amt == '.')
+            decimals = 0;
+        else if(*amt >= '0' && *amt <= '9' && decimals < 2)
+        {
+            cents = (cents * 10) + (*amt - '0');
+            if(decimals >= 0)
+                decimals++;
+        }
+    }
+
+    if(decimals < 1)//no cents were given ('$5' or '$5.'), pad them on
+        cents *= 100;
+    else if(decimals == 1)//only tenths were given ('$5.5')
+        cents *= 10;
+
+    return negative ? -cents : cents;
+}//END strToCents
+
+void printCents(FILE* stream, long long cents)
+{
+    if(cents < 0)
+    {
+        fprintf(stream, "-");
+        cents = -cents;
+    }
+
+    fprintf(stream, "$%lld.%02lld", cents / 100, cents % 100);
+    return;
+}//END printCents
+
+void convertRow(struct row* temp)
+{
+    temp->mobileCents = strToCents(fieldText(&temp->mobileAmt));
+    temp->discountCents = strToCents(fieldText(&temp->discountAmt));
+    temp->feeCents = strToCents(fieldText(&temp->feeAmt));
+    temp->netCents = strToCents(fieldText(&temp->netAmt));
+    temp->totalCents = rowTotal(temp->mobileCents, temp->discountCents, temp->feeCents);
+    return;
+}//END convertRow
+
+void reconcileRow(struct centBatch* batch, struct row* temp)
+{
+    //Copy the row's cents into the batch, check the batch once it is full
+    int i = batch->count++;
+
+    batch->mobile[i] = temp->mobileCents;
+    batch->discount[i] = temp->discountCents;
+    batch->fee[i] = temp->feeCents;
+    batch->net[i] = temp->netCents;
+    batch->nameId[i] = temp->nameId;
+
+    if(batch->count == RECONCILE_BATCH)
+        reconcileBatch(batch);
+
+    return;
+}//END reconcileRow
+
+void reconcileBatch(struct centBatch* batch)
+{
+    /*
+    Net should be Mobile minus Fee minus Discounts to the cent. The first
+    loop has no branches so the compiler can do several rows per
+    instruction, the rows are only looked at one by one when at least one
+    of them is off.
+    */
+
+    //Local Variable(s)
+    long long off[RECONCILE_BATCH];
+    long long any = 0;
+    struct mismatch* temp;
+    int i;
+
+    for(i = batch->count; i < RECONCILE_BATCH; i++)//the last batch of a file is short, pad it with rows that add up
+    {
+        batch->mobile[i] = 0;
+        batch->discount[i] = 0;
+        batch->fee[i] = 0;
+        batch->net[i] = 0;
+    }
+
+    for(i = 0; i < RECONCILE_BATCH; i++)//whole batch, a fixed count is what lets -O2 vectorize it
+    {
+        off[i] = batch->net[i] - (batch->mobile[i] - batch->fee[i] - batch->discount[i]);
+        any |= off[i];
+    }
+
+    for(i = 0; any != 0 && i < batch->count; i++)
+    {
+        if(off[i] == 0)
+            continue;
+
+        if(batch->foundCount == batch->foundSize)
+        {
+            batch->foundSize = (batch->foundSize > 0) ? batch->foundSize * 2 : 64;
+            batch->found = (struct mismatch*)realloc(batch->found, batch->foundSize * sizeof(struct mismatch));
+        }
+
+        temp = &batch->found[batch->foundCount++];
+        temp->nameId = batch->nameId[i];
+        temp->mobileCents = batch->mobile[i];
+        temp->discountCents = batch->discount[i];
+        temp->feeCents = batch->fee[i];
+        temp->netCents = batch->net[i];
+    }
+
+    batch->checked += batch->count;
+    batch->count = 0;
+
+    return;
+}//END reconcileBatch
+
+void writeReconcileReport(const char* base, struct centBatch* batches, int count)
+{
+    /*
+    Checks what is left in each batch & writes every row that was off to
+    <file>_reconcile.csv, batches in file order. The report is written even
+    when nothing was off, so an old one never hangs around looking current.
+    */
+
+    //Local Variable(s)
+    FILE* stream;
+    struct mismatch* temp;
+    char* s = concat(base, "_reconcile.csv");
+    int i;
+    int j;
+
+    stream = openOutput(s);
+    fprintf(stream, "Display Name,Mobile Amt,Discounts,Fee,Net Amt,Expected Net,Off By\n");
+
+    for(i = 0; i < count; i++)
+    {
+        reconcileBatch(&batches[i]);
+        reconcileChecked += batches[i].checked;
+        reconcileMismatched += batches[i].foundCount;
+
+        for(j = 0; j < batches[i].foundCount; j++)
+        {
+            temp = &batches[i].found[j];
+            csvString(stream, nameText(temp->nameId), strlen(nameText(temp->nameId))); fprintf(stream, ",");
+            printCents(stream, temp->mobileCents); fprintf(stream, ",");
+            printCents(stream, temp->discountCents); fprintf(stream, ",");
+            printCents(stream, temp->feeCents); fprintf(stream, ",");
+            printCents(stream, temp->netCents); fprintf(stream, ",");
+            printCents(stream, temp->mobileCents - temp->feeCents - temp->discountCents); fprintf(stream, ",");
+            printCents(stream, temp->netCents - (temp->mobileCents - temp->feeCents - temp->discountCents)); fprintf(stream, "\n");
+        }
+
+        free(batches[i].found);
+        batches[i].found = NULL;
+        batches[i].foundCount = 0;
+        batches[i].foundSize = 0;
+        batches[i].checked = 0;
+    }
+
+    closeOutput(stream);
+    free(s);
+
+    return;
+}//END writeReconcileReport
+
+int accountKeyLength(const char* name)
+{
+    int i;
+    int seperatorLoc = -1;
+
+    //Same rule isNextMatch() uses: the account is everything before the last '-'
+    for(i = 0; name[i] != '\0'; i++)
+    {
+        if(name[i] == '-')
+            seperatorLoc = i;
+    }
+
+    return (seperatorLoc < 0) ? i : seperatorLoc; //no '-', the whole name is the account
+}//END accountKeyLength
+
+void initNames()
+{
+    int i;
+
+    initPool(&names, "Display Names", NAME_SLOTS, true);
+    initPool(&dictionaries[DICT_CITY], "Cities", DICT_SLOTS, false);
+    initPool(&dictionaries[DICT_STATE], "States", DICT_SLOTS, false);
+    initPool(&dictionaries[DICT_ZIP], "Zip Codes", DICT_SLOTS, false);
+    initPool(&dictionaries[DICT_TAGS], "Tags", DICT_SLOTS, false);
+    initPool(&dictionaries[DICT_MACHINE], "Machine IDs", DICT_SLOTS, false);
+
+    internString(&names, ""); //ID 0, what nullify() gives a row
+    for(i = 0; i < DICT_COLUMNS; i++)
+        internString(&dictionaries[i], "");
+
+    return;
+}//END initNames
+
+void initPool(struct stringPool* pool, const char* what, unsigned slotCount, bool accounts)
+{
+    memset(pool, 0, sizeof(struct stringPool));
+    pool->what = what;
+    pool->accounts = accounts;
+    pool->slotCount = slotCount;
+    pool->slots = (atomic_uint*)calloc(slotCount, sizeof(atomic_uint));
+    pthread_rwlock_init(&pool->resize, NULL);
+    atomic_store(&pool->count, 0);
+    return;
+}//END initPool
+
+void growPool(struct stringPool* pool)
+{
+    /*
+    Doubles the hash slots & puts every string back in. Interning holds
+    the read side of pool->resize, so once we have the write side nobody
+    is probing and every slot is published. Entries stay where they are,
+    IDs don't change.
+    */
+
+    //Local Variable(s)
+    atomic_uint* slots;
+    unsigned slotCount;
+    unsigned count;
+    unsigned i;
+    unsigned k;
+
+    pthread_rwlock_wrlock(&pool->resize);
+    count = atomic_load(&pool->count);
+
+    if(count + 1 >= pool->slotCount / 2)//someone else may have grown it while we waited
+    {
+        slotCount = pool->slotCount * 2;
+        slots = (atomic_uint*)calloc(slotCount, sizeof(atomic_uint));
+
+        for(i = 0; i < count; i++)
+        {
+            for(k = poolEntry(pool, i)->hash; atomic_load(&slots[k & (slotCount - 1)]) != 0; k++)
+                ; //next free slot
+
+            atomic_store(&slots[k & (slotCount - 1)], i + 1);
+        }
+
+        free(pool->slots);
+        pool->slots = slots;
+        pool->slotCount = slotCount;
+    }
+
+    pthread_rwlock_unlock(&pool->resize);
+    return;
+}//END growPool
+
+unsigned internString(struct stringPool* pool, const char* text)
+{
+    /*
+    Lock-free, so parse workers can all intern at once. A free slot is
+    claimed with NAME_BUSY, the string is filled in and then the slot is
+    set to its ID + 1. Anyone who finds a busy slot waits for it to be
+    published before comparing against it.
+    */
+
+    //Local Variable(s)
+    char buffer[MAX_CSV_LEN];
+    char* prefix = buffer;
+    atomic_uint* slot;
+    struct internedName* entry;
+    struct internedName* page;
+    struct internedName* expected;
+    unsigned hash = hashString(text);
+    unsigned i = hash;
+    unsigned claimed;
+    unsigned id;
+    unsigned accountId = NAME_BUSY; //NAME_BUSY here means "ourself"
+    bool grow;
+    int length = strlen(text);
+    int prefixLength = pool->accounts ? accountKeyLength(text) : length;
+    int k;
+
+    //Intern the account part first, waiting on it while we hold a busy slot could deadlock
+    if(prefixLength < length)
+    {
+        if(prefixLength >= MAX_CSV_LEN)//a very long account name, don't cut it short
+            prefix = (char*)malloc(prefixLength + 1);
+
+        memcpy(prefix, text, prefixLength);
+        prefix[prefixLength] = '\0';
+        accountId = internString(pool, prefix);
+
+        if(prefix != buffer)
+            free(prefix);
+    }
+
+    pthread_rwlock_rdlock(&pool->resize); //the slots can't be swapped out from under us
+
+    for(;; i++)
+    {
+        slot = &pool->slots[i & (pool->slotCount - 1)];
+        claimed = atomic_load_explicit(slot, memory_order_acquire);
+
+        if(claimed == 0)
+        {
+            if(atomic_compare_exchange_strong(slot, &claimed, NAME_BUSY))
+                break; //slot is ours, fill it in below
+        }
+
+        while(claimed == NAME_BUSY)//being filled in, wait for it
+        {
+            sched_yield();
+            claimed = atomic_load_explicit(slot, memory_order_acquire);
+        }
+
+        entry = poolEntry(pool, claimed - 1);
+
+        if(entry->hash == hash && strcmp(entry->text, text) == 0)//already interned
+        {
+            pthread_rwlock_unlock(&pool->resize);
+            return claimed - 1;
+        }
+    }
+
+    id = atomic_fetch_add(&pool->count, 1);
+
+    if(id >= NAME_PAGE * MAX_NAME_PAGES)//hundreds of millions, memory runs out long before this
+    {
+        printf("Error: Too many different %s, can not continue.\n", pool->what);
+        exit(1);
+    }
+
+    page = atomic_load(&pool->pages[id / NAME_PAGE]);
+
+    if(page == NULL)//first string of a new page, whoever gets their page in first wins
+    {
+        page = (struct internedName*)calloc(NAME_PAGE, sizeof(struct internedName));
+        expected = NULL;
+
+        if(!atomic_compare_exchange_strong(&pool->pages[id / NAME_PAGE], &expected, page))
+        {
+            free(page);
+            page = expected;
+        }
+    }
+
+    entry = &page[id % NAME_PAGE];
+    entry->text = (char*)malloc(length + 1);
+    strcpy(entry->text, text);
+    entry->hash = hash;
+    entry->prefixLength = prefixLength;
+    entry->accountId = (accountId == NAME_BUSY) ? id : accountId;
+    entry->sortKey = 0;
+    entry->collateKey = (unsigned char*)text; //binary order, the key is the text itself
+    entry->collateLength = length;
+
+    if(pool->accounts && humanOrder)
+    {
+        entry->collateKey = (unsigned char*)malloc(3 * length + 1); //a 1 digit run is 3 bytes
+        entry->collateLength = collationKey(text, entry->collateKey);
+    }
+
+    for(k = 0; k < 8; k++)//short keys are padded with 0s, same as strcmp hitting the end
+        entry->sortKey = (entry->sortKey << 8) | (k < entry->collateLength ? entry->collateKey[k] : 0);
+
+    if(entry->collateKey == (unsigned char*)text)
+        entry->collateKey = NULL; //text goes away, compareNames() uses entry->text instead
+
+    atomic_store_explicit(slot, id + 1, memory_order_release); //publish it
+    grow = (id + 1 >= pool->slotCount / 2); //half full, probing gets slow & the table must never fill
+    pthread_rwlock_unlock(&pool->resize);
+
+    if(grow)
+        growPool(pool);
+
+    return id;
+}//END internString
+
+struct internedName* poolEntry(struct stringPool* pool, unsigned id)
+{
+    return &atomic_load_explicit(&pool->pages[id / NAME_PAGE], memory_order_acquire)[id % NAME_PAGE];
+}//END poolEntry
+
+unsigned internName(const char* text)
+{
+    return internString(&names, text);
+}//END internName
+
+struct internedName* nameEntry(unsigned id)
+{
+    return poolEntry(&names, id);
+}//END nameEntry
+
+const char* nameText(unsigned id)
+{
+    return poolEntry(&names, id)->text;
+}//END nameText
+
+const char* dictText(int column, unsigned code)
+{
+    return poolEntry(&dictionaries[column], code)->text;
+}//END dictText
+
+int compareNames(unsigned a, unsigned b)
+{
+    /*
+    Human order sorts by account first so every account still comes out
+    in one piece for printRows(), even when "Adcomm" & "adcomm" collate
+    the same. Ties on the key are broken by the raw text so the order is
+    always total.
+    */
+
+    //Local Variable(s)
+    struct internedName* x;
+    struct internedName* y;
+    int cmp;
+
+    if(a == b)//same ID, same name
+        return 0;
+
+    x = nameEntry(a);
+    y = nameEntry(b);
+
+    if(humanOrder && x->accountId != y->accountId)
+    {
+        x = nameEntry(x->accountId);
+        y = nameEntry(y->accountId);
+    }
+
+    cmp = compareKeys(x, y);
+
+    return (cmp != 0) ? cmp : strcmp(x->text, y->text);
+}//END compareNames
+
+int compareKeys(struct internedName* x, struct internedName* y)
+{
+    //Local Variable(s)
+    int cmp;
+
+    if(x->sortKey != y->sortKey)//decided in the first 8 bytes, no need to walk the keys
+        return (x->sortKey < y->sortKey) ? -1 : 1;
+
+    if(x->collateKey == NULL || y->collateKey == NULL)//binary order, the key is the text
+        return strcmp(x->text, y->text);
+
+    cmp = memcmp(x->collateKey, y->collateKey, (x->collateLength < y->collateLength) ? x->collateLength : y->collateLength);
+
+    return (cmp != 0) ? cmp : x->collateLength - y->collateLength;
+}//END compareKeys
+
+int collationKey(const char* text, unsigned char* key)
+{
+    /*
+    Builds the --collate human key for text and returns its length.
+        Letters are lower cased, Latin-1 accents (UTF-8 or raw bytes) are
+            folded onto the plain letter
+        A digit run has its leading 0s dropped and becomes '0', the count
+            of digits left & the digits, so shorter numbers sort first
+        Anything else is copied as is
+    */
+
+    //Local Variable(s)
+    const char* fold = "aaaaaaaceeeeiiiidnooooo*ouuuuyts"; //0xC0-0xDF & 0xE0-0xFF, '*' = not a letter
+    const unsigned char* c = (const unsigned char*)text;
+    unsigned char latin;
+    int length = 0;
+    int digits;
+
+    while(*c != '\0')
+    {
+        if(*c >= '0' && *c <= '9')
+        {
+            while(*c == '0' && c[1] >= '0' && c[1] <= '9')//keep one 0 if that is all there is
+                c++;
+
+            for(digits = 0; c[digits] >= '0' && c[digits] <= '9'; digits++)
+                ;
+
+            key[length++] = '0';
+            key[length++] = (digits > 255) ? 255 : digits;
+            memcpy(key + length, c, digits);
+            length += digits;
+            c += digits;
+            continue;
+        }
+
+        latin = 0;
+        if(*c == 0xC3 && c[1] >= 0x80 && c[1] <= 0xBF)//UTF-8 for U+00C0 to U+00FF
+        {
+            latin = c[1] + 0x40;
+            c++;
+        }
+        else if(*c >= 0xC0 && (c[1] < 0x80 || c[1] > 0xBF))//raw Latin-1 from a Windows export, not UTF-8
+            latin = *c;
+
+        if(latin == 0xFF)
+            key[length++] = 'y';
+        else if(latin != 0 && fold[latin & 0x1F] != '*')
+            key[length++] = fold[latin & 0x1F];
+        else if(latin != 0)
+            key[length++] = latin;
+        else if(*c >= 'A' && *c <= 'Z')
+            key[length++] = *c - 'A' + 'a';
+        else
+            key[length++] = *c;
+
+        c++;
+    }
+
+    return length;
+}//END collationKey
+
+int accountLength(const char* name)
+{
+    int seperatorLoc = accountKeyLength(name);
+
+    //drop the space(s) before the '-' so "Adcomm - Coke" groups as "Adcomm"
+    while(seperatorLoc > 0 && name[seperatorLoc - 1] == ' ')
+        seperatorLoc--;
+
+    return seperatorLoc;
+}//END accountLength
+
+bool addGroupSet(const char* columns)
+{
+    //Local Variable(s)
+    char str[MAX_CSV_LEN];
+    char *token;
+    unsigned mask = 0;
+
+    if(groupSetCount == MAX_GROUP_SETS)
+        return false;
+
+    strncpy(str, columns, MAX_CSV_LEN - 1);
+    str[MAX_CSV_LEN - 1] = '\0';
+
+    token = strtok(str, comma);
+
+    while(token != NULL)
+    {
+        if(strcmp(token, "name") == 0)
+            mask |= GROUP_DNAME;
+        else if(strcmp(token, "account") == 0)
+            mask |= GROUP_ACCOUNT;
+        else if(strcmp(token, "city") == 0)
+            mask |= GROUP_CITY;
+        else if(strcmp(token, "state") == 0)
+            mask |= GROUP_STATE;
+        else if(strcmp(token, "zip") == 0)
+            mask |= GROUP_ZIP;
+        else if(strcmp(token, "tags") == 0)
+            mask |= GROUP_TAGS;
+        else if(strcmp(token, "machine") == 0)
+            mask |= GROUP_MACHINE;
+        else
+            return false;
+
+        token = strtok(NULL, comma);
+    }
+
+    groupSets[groupSetCount++] = mask; //empty mask is the grand total
+    return true;
+}//END addGroupSet
+
+void buildGroupKey(struct row* node, unsigned mask, unsigned* codes)
+{
+    /*
+    Codes are always in the same order (widest to narrowest) no matter
+    what order the columns were asked for, so "city,state" and
+    "state,city" describe the same groups. Columns not in the set stay 0.
+    */
+    memset(codes, 0, GROUP_COLUMNS * sizeof(unsigned));
+
+    if(mask & GROUP_STATE)   codes[0] = node->state;
+    if(mask & GROUP_CITY)    codes[1] = node->city;
+    if(mask & GROUP_ZIP)     codes[2] = node->zipCode;
+    if(mask & GROUP_TAGS)    codes[3] = node->tags;
+    if(mask & GROUP_ACCOUNT) codes[4] = nameEntry(node->nameId)->accountId;
+    if(mask & GROUP_DNAME)   codes[5] = node->nameId;
+    if(mask & GROUP_MACHINE) codes[6] = node->machineId;
+
+    return;
+}//END buildGroupKey
+
+char* groupKeyText(unsigned mask, const unsigned* codes)
+{
+    /*
+    Only done once per group, when it is created. Column values can be any
+    length, so the parts are gathered first and the key is sized to fit.
+    */
+
+    //Local Variable(s)
+    const char* parts[GROUP_COLUMNS];
+    int lengths[GROUP_COLUMNS];
+    int count = 0;
+    int account = -1; //which part is the account, -1 if none
+    size_t size = 1;
+    char* key;
+    char* end;
+    int i;
+
+    if(mask & GROUP_STATE)
+        parts[count++] = dictText(DICT_STATE, codes[0]);
+    if(mask & GROUP_CITY)
+        parts[count++] = dictText(DICT_CITY, codes[1]);
+    if(mask & GROUP_ZIP)
+        parts[count++] = dictText(DICT_ZIP, codes[2]);
+    if(mask & GROUP_TAGS)
+        parts[count++] = dictText(DICT_TAGS, codes[3]);
+    if(mask & GROUP_ACCOUNT)
+        account = count++; //only the part of the Display Name up to the '-'
+    if(mask & GROUP_DNAME)
+        parts[count++] = nameText(codes[5]);
+    if(mask & GROUP_MACHINE)
+        parts[count++] = dictText(DICT_MACHINE, codes[6]);
+
+    if(count == 0)
+        return strdup("Grand Total");
+
+    for(i = 0; i < count; i++)
+    {
+        if(i == account)
+        {
+            parts[i] = nameText(codes[4]);
+            lengths[i] = accountLength(parts[i]);
+        }
+        else
+        {
+            lengths[i] = (int)strlen(parts[i]);
+        }
+
+        size += lengths[i] + 3; //" | " between the parts, one more than needed
+    }
+
+    key = (char*)malloc(size);
+    end = key;
+
+    for(i = 0; i < count; i++)
+    {
+        if(i > 0)
+        {
+            memcpy(end, " | ", 3);
+            end += 3;
+        }
+
+        memcpy(end, parts[i], lengths[i]);
+        end += lengths[i];
+    }
+
+    *end = '\0';
+    return key;
+}//END groupKeyText
+
+void groupSetName(unsigned mask, char* name)
+{
+    name[0] = '\0';
+
+    if(mask & GROUP_STATE)   strcat(name, "State/");
+    if(mask & GROUP_CITY)    strcat(name, "City/");
+    if(mask & GROUP_ZIP)     strcat(name, "Zip Code/");
+    if(mask & GROUP_TAGS)    strcat(name, "Tags/");
+    if(mask & GROUP_ACCOUNT) strcat(name, "Account/");
+    if(mask & GROUP_DNAME)   strcat(name, "Display Name/");
+    if(mask & GROUP_MACHINE) strcat(name, "Machine ID/");
+
+    if(mask == 0)
+        strcpy(name, "All");
+    else
+        name[strlen(name) - 1] = '\0'; //remove the trailing '/'
+
+    return;
+}//END groupSetName
+
+unsigned hashString(const char* str)
+{
+    unsigned hash = 2166136261u; //FNV-1a
+
+    while(*str != '\0')
+    {
+        hash ^= (unsigned char)*str++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}//END hashString
+
+void groupRow(struct groupTable* table, struct row* node)
+{
+    //Local Variable(s)
+    unsigned codes[GROUP_COLUMNS];
+    struct group* temp;
+    unsigned bucket;
+    int i;
+    int k;
+
+    for(i = 0; i < groupSetCount; i++)//add this row to every grouping set
+    {
+        buildGroupKey(node, groupSets[i], codes);
+
+        bucket = 2166136261u + i; //FNV-1a over the codes, same as hashString()
+        for(k = 0; k < GROUP_COLUMNS; k++)
+            bucket = (bucket ^ codes[k]) * 16777619u;
+        bucket %= GROUP_BUCKETS;
+
+        temp = table->buckets[bucket];
+        while(temp != NULL && (temp->set != i || memcmp(temp->codes, codes, sizeof(codes)) != 0))
+            temp = temp->next;
+
+        if(temp == NULL)//first row of this group, create it
+        {
+            temp = (struct group*)calloc(1, sizeof(struct group));
+            temp->set = i;
+            memcpy(temp->codes, codes, sizeof(codes));
+            temp->key = groupKeyText(groupSets[i], codes);
+            temp->next = table->buckets[bucket];
+            table->buckets[bucket] = temp;
+            table->count++;
+        }
+
+        temp->rows++;
+        temp->mobileCents += node->mobileCents;
+        temp->discountCents += node->discountCents;
+        temp->feeCents += node->feeCents;
+        temp->netCents += node->netCents;
+        temp->totalCents += node->totalCents;
+    }
+
+    return;
+}//END groupRow
+
+void mergeGroups(struct groupTable* into, struct groupTable* from)
+{
+    /*
+    Same hash, so same bucket in both tables. A group into doesn't have
+    yet is moved over whole, key & all, the rest are added up & freed.
+    from is left empty.
+    */
+
+    //Local Variable(s)
+    struct group* temp;
+    struct group* next;
+    struct group* match;
+    int i;
+
+    for(i = 0; i < GROUP_BUCKETS; i++)
+    {
+        for(temp = from->buckets[i]; temp != NULL; temp = next)
+        {
+            next = temp->next;
+            match = into->buckets[i];
+            while(match != NULL && (match->set != temp->set || memcmp(match->codes, temp->codes, sizeof(temp->codes)) != 0))
+                match = match->next;
+
+            if(match == NULL)
+            {
+                temp->next = into->buckets[i];
+                into->buckets[i] = temp;
+                into->count++;
+                continue;
+            }
+
+            match->rows += temp->rows;
+            match->mobileCents += temp->mobileCents;
+            match->discountCents += temp->discountCents;
+            match->feeCents += temp->feeCents;
+            match->netCents += temp->netCents;
+            match->totalCents += temp->totalCents;
+            free(temp->key);
+            free(temp);
+        }
+
+        from->buckets[i] = NULL;
+    }
+
+    from->count = 0;
+    return;
+}//END mergeGroups
+
+int compareGroups(const void* a, const void* b)
+{
+    const struct group* x = *(const struct group**)a;
+    const struct group* y = *(const struct group**)b;
+
+    if(x->set != y->set)//levels stay in the order they were asked for
+        return x->set - y->set;
+
+    return strcmp(x->key, y->key);
+}//END compareGroups
+
+void writeRollupFile()
+{
+    //Local Variable(s)
+    FILE* stream;
+    struct group** groups = (struct group**)malloc((rollups.count + 1) * sizeof(struct group*));
+    struct group* temp;
+    char name[MAX_STRING_LEN];
+    char* s = concat(filename, "_rollup.csv");
+    int count = 0;
+    int i;
+
+    //Pull every group out of the hash table so they can be sorted for printing
+    for(i = 0; i < GROUP_BUCKETS; i++)
+    {
+        for(temp = rollups.buckets[i]; temp != NULL; temp = temp->next)
+            groups[count++] = temp;
+    }
+
+    qsort(groups, count, sizeof(struct group*), compareGroups);
+
+    stream = openOutput(s);
+    fprintf(stream, "Level,Group,Rows,Mobile,Discounts,Fee,Net,Total\n");
+
+    for(i = 0; i < count; i++)
+    {
+        groupSetName(groupSets[groups[i]->set], name);
+        fprintf(stream, "%s,", name);
+        csvString(stream, groups[i]->key, strlen(groups[i]->key));
+        fprintf(stream, ",%d,", groups[i]->rows);
+        printCents(stream, groups[i]->mobileCents); fprintf(stream, ",");
+        printCents(stream, groups[i]->discountCents); fprintf(stream, ",");
+        printCents(stream, groups[i]->feeCents); fprintf(stream, ",");
+        printCents(stream, groups[i]->netCents); fprintf(stream, ",");
+        printCents(stream, groups[i]->totalCents); fprintf(stream, "\n");
+    }
+
+    closeOutput(stream);
+
+    free(groups);
+    free(s);
+    freeGroups(&rollups);
+    return;
+}//END writeRollupFile
+
+void addToAccount(struct accountTable* table, struct row* node)
+{
+    //Local Variable(s)
+    struct accountTotal* temp;
+    unsigned key = nameEntry(node->nameId)->accountId;
+    unsigned bucket = nameEntry(key)->hash % ACCOUNT_BUCKETS;
+
+    temp = table->buckets[bucket];
+    while(temp != NULL && temp->accountId != key)
+        temp = temp->next;
+
+    if(temp == NULL)//first row of this account
+    {
+        temp = (struct accountTotal*)calloc(1, sizeof(struct accountTotal));
+        temp->accountId = key;
+        temp->next = table->buckets[bucket];
+        table->buckets[bucket] = temp;
+        table->count++;
+    }
+
+    temp->rows++;
+    temp->mobileCents += node->mobileCents;
+    temp->discountCents += node->discountCents;
+    temp->feeCents += node->feeCents;
+    temp->netCents += node->netCents;
+    temp->totalCents += node->totalCents;
+
+    return;
+}//END addToAccount
+
+void mergeAccounts(struct accountTable* into, struct accountTable* from)
+{
+    //Local Variable(s)
+    struct accountTotal* temp;
+    struct accountTotal* match;
+    int i;
+
+    for(i = 0; i < ACCOUNT_BUCKETS; i++)//same hash, so same bucket in both tables
+    {
+        for(temp = from->buckets[i]; temp != NULL; temp = temp->next)
+        {
+            match = into->buckets[i];
+            while(match != NULL && match->accountId != temp->accountId)
+                match = match->next;
+
+            if(match == NULL)
+            {
+                match = (struct accountTotal*)calloc(1, sizeof(struct accountTotal));
+                match->accountId = temp->accountId;
+                match->next = into->buckets[i];
+                into->buckets[i] = match;
+                into->count++;
+            }
+
+            match->rows += temp->rows;
+            match->mobileCents += temp->mobileCents;
+            match->discountCents += temp->discountCents;
+            match->feeCents += temp->feeCents;
+            match->netCents += temp->netCents;
+            match->totalCents += temp->totalCents;
+        }
+    }
+
+    return;
+}//END mergeAccounts
+
+void freeAccounts(struct accountTable* table)
+{
+    struct accountTotal* temp;
+    int i;
+
+    for(i = 0; i < ACCOUNT_BUCKETS; i++)
+    {
+        while(table->buckets[i] != NULL)
+        {
+            temp = table->buckets[i]->next;
+            free(table->buckets[i]);
+            table->buckets[i] = temp;
+        }
+    }
+
+    table->count = 0;
+    return;
+}//END freeAccounts
+
+void sharedMapInit(struct sharedMap* map)
+{
+    map->slots = (struct sharedSlot*)calloc(SHARED_MAP_SLOTS, sizeof(struct sharedSlot));
+    atomic_store(&map->count, 0);
+    return;
+}//END sharedMapInit
+
+bool sharedMapAdd(struct sharedMap* map, struct row* node)
+{
+    //Local Variable(s)
+    struct sharedSlot* slot = NULL;
+    unsigned key = nameEntry(node->nameId)->accountId + 1; //+1 so 0 can mean free
+    unsigned i = nameEntry(key - 1)->hash;
+    unsigned claimed;
+    unsigned probe;
+
+    for(probe = 0; probe < SHARED_MAP_SLOTS && slot == NULL; probe++, i++)
+    {
+        slot = &map->slots[i & (SHARED_MAP_SLOTS - 1)];
+        claimed = atomic_load_explicit(&slot->account, memory_order_acquire);
+
+        if(claimed == 0)//free slot, try to make it ours
+        {
+            if(atomic_compare_exchange_strong(&slot->account, &claimed, key))
+            {
+                atomic_fetch_add(&map->count, 1);
+                continue; //slot is ours
+            }
+
+            //someone beat us to it, claimed now holds their account, see if it is the same one
+        }
+
+        if(claimed != key)//someone else's account, keep probing
+            slot = NULL;
+    }
+
+    if(slot == NULL)//map is full, caller keeps it in its own table
+        return false;
+
+    atomic_fetch_add_explicit(&slot->rows, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->mobileCents, node->mobileCents, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->discountCents, node->discountCents, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->feeCents, node->feeCents, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->netCents, node->netCents, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->totalCents, node->totalCents, memory_order_relaxed);
+
+    return true;
+}//END sharedMapAdd
+
+void sharedMapSnapshot(struct sharedMap* map, struct accountTable* table)
+{
+    //Local Variable(s)
+    struct accountTable copy; //built on the side then merged, so the table only sees whole accounts
+    struct accountTotal* temp;
+    unsigned claimed;
+    unsigned bucket;
+    int i;
+
+    memset(&copy, 0, sizeof(struct accountTable));
+
+    for(i = 0; i < SHARED_MAP_SLOTS; i++)
+    {
+        claimed = atomic_load_explicit(&map->slots[i].account, memory_order_acquire);
+
+        if(claimed == 0)
+            continue;
+
+        temp = (struct accountTotal*)calloc(1, sizeof(struct accountTotal));
+        temp->accountId = claimed - 1;
+        temp->rows = atomic_load_explicit(&map->slots[i].rows, memory_order_relaxed);
+        temp->mobileCents = atomic_load_explicit(&map->slots[i].mobileCents, memory_order_relaxed);
+        temp->discountCents = atomic_load_explicit(&map->slots[i].discountCents, memory_order_relaxed);
+        temp->feeCents = atomic_load_explicit(&map->slots[i].feeCents, memory_order_relaxed);
+        temp->netCents = atomic_load_explicit(&map->slots[i].netCents, memory_order_relaxed);
+        temp->totalCents = atomic_load_explicit(&map->slots[i].totalCents, memory_order_relaxed);
+
+        bucket = nameEntry(temp->accountId)->hash % ACCOUNT_BUCKETS;
+        temp->next = copy.buckets[bucket];
+        copy.buckets[bucket] = temp;
+        copy.count++;
+    }
+
+    mergeAccounts(table, &copy);
+    freeAccounts(&copy);
+    return;
+}//END sharedMapSnapshot
+
+void sharedMapFree(struct sharedMap* map)
+{
+    free(map->slots);
+    map->slots = NULL;
+    return;
+}//END sharedMapFree
+
+void freeGroups(struct groupTable* table)
+{
+    struct group* temp;
+    int i;
+
+    for(i = 0; i < GROUP_BUCKETS; i++)
+    {
+        while(table->buckets[i] != NULL)
+        {
+            temp = table->buckets[i]->next;
+            free(table->buckets[i]->key);
+            free(table->buckets[i]);
+            table->buckets[i] = temp;
+        }
+    }
+
+    table->count = 0;
+    return;
+}//END freeGroups
+
+void topRow(unsigned nameId, long long mobile, long long discount, long long fee, long long net)
+{
+    /*
+    Called for every row as it is written. Rows come out in name order so
+    a machine (or account) is complete as soon as a row with another key
+    shows up, only then is it offered to the heap.
+    */
+    unsigned key;
+
+    if(topCount <= 0)
+        return;
+
+    key = topMachines ? nameId : nameEntry(nameId)->accountId;
+
+    if(topPending.rows > 0 && topPending.nameId != key)
+    {
+        topOffer(&topPending);
+        memset(&topPending, 0, sizeof(struct topEntry));
+    }
+
+    topPending.nameId = key;
+    topPending.rows++;
+    topPending.mobileCents += mobile;
+    topPending.discountCents += discount;
+    topPending.feeCents += fee;
+    topPending.netCents += net;
+    topPending.totalCents += rowTotal(mobile, discount, fee);
+
+    return;
+}//END topRow
+
+bool topWorse(struct topEntry* a, struct topEntry* b)
+{
+    //true when a ranks below b, ties go to the name that sorts first
+    long double x, y;
+
+    switch(topMetric)
+    {
+        case TOP_DISCOUNTS: x = a->discountCents; y = b->discountCents; break;
+        case TOP_FEE:       x = a->feeCents;      y = b->feeCents;      break;
+        case TOP_NET:       x = a->netCents;      y = b->netCents;      break;
+        case TOP_TOTAL:     x = a->totalCents;    y = b->totalCents;    break;
+        case TOP_SHARE:
+            x = (a->mobileCents > 0) ? (long double)a->discountCents / a->mobileCents : 0;
+            y = (b->mobileCents > 0) ? (long double)b->discountCents / b->mobileCents : 0;
+            break;
+        default:            x = a->mobileCents;   y = b->mobileCents;   break;
+    }
+
+    if(x != y)
+        return x < y;
+
+    return compareNames(a->nameId, b->nameId) > 0;
+}//END topWorse
+
+void topOffer(struct topEntry* entry)
+{
+    //Local Variable(s)
+    struct topEntry swap;
+    int i;
+
+    if(topHeap == NULL)
+        topHeap = (struct topEntry*)malloc(topCount * sizeof(struct topEntry));
+
+    if(topSize < topCount)//not full yet, sift it up
+    {
+        i = topSize++;
+        topHeap[i] = *entry;
+
+        while(i > 0 && topWorse(&topHeap[i], &topHeap[(i - 1) / 2]))
+        {
+            swap = topHeap[i];
+            topHeap[i] = topHeap[(i - 1) / 2];
+            topHeap[(i - 1) / 2] = swap;
+            i = (i - 1) / 2;
+        }
+        return;
+    }
+
+    if(topWorse(entry, &topHeap[0]))
+        return; //doesn't make the cut
+
+    topHeap[0] = *entry; //replace the worst & sift it down
+    topSiftDown();
+    return;
+}//END topOffer
+
+void topSiftDown()
+{
+    //Local Variable(s)
+    struct topEntry swap;
+    int i = 0;
+    int child;
+
+    while((child = 2 * i + 1) < topSize)
+    {
+        if(child + 1 < topSize && topWorse(&topHeap[child + 1], &topHeap[child]))
+            child++;
+
+        if(!topWorse(&topHeap[child], &topHeap[i]))
+            break;
+
+        swap = topHeap[i];
+        topHeap[i] = topHeap[child];
+        topHeap[child] = swap;
+        i = child;
+    }
+
+    return;
+}//END topSiftDown
+
+void writeTopReport(const char* base)
+{
+    /*
+    Pops the heap worst first, filling the array from the back, so the
+    report comes out best first. Resets everything for the next file.
+    */
+
+    //Local Variable(s)
+    FILE* stream;
+    struct topEntry* ranked;
+    char* s = concat(base, "_top.csv");
+    const char* name;
+    int count;
+    int i;
+
+    if(topPending.rows > 0)//last one never saw a row with another key
+        topOffer(&topPending);
+
+    count = topSize;
+    ranked = (struct topEntry*)malloc((topSize + 1) * sizeof(struct topEntry));
+
+    while(topSize > 0)
+    {
+        ranked[topSize - 1] = topHeap[0];
+        topHeap[0] = topHeap[--topSize]; //last entry to the top & sift it back into place
+        topSiftDown();
+    }
+
+    stream = openOutput(s);
+    fprintf(stream, "Rank,%s,Rows,Mobile,Discounts,Fee,Net,Total,Discount Share\n", topMachines ? "Display Name" : "Account");
+
+    for(i = 0; i < count; i++)
+    {
+        name = nameText(ranked[i].nameId);
+        fprintf(stream, "%d,", i + 1);
+        csvString(stream, name, topMachines ? (int)strlen(name) : accountLength(name));
+        fprintf(stream, ",%d,", ranked[i].rows);
+        printCents(stream, ranked[i].mobileCents); fprintf(stream, ",");
+        printCents(stream, ranked[i].discountCents); fprintf(stream, ",");
+        printCents(stream, ranked[i].feeCents); fprintf(stream, ",");
+        printCents(stream, ranked[i].netCents); fprintf(stream, ",");
+        printCents(stream, ranked[i].totalCents); fprintf(stream, ",");
+        fprintf(stream, "%.2f%%\n", (ranked[i].mobileCents > 0) ? 100.0 * ranked[i].discountCents / ranked[i].mobileCents : 0.0);
+    }
+
+    closeOutput(stream);
+    printf("Top %d %s written to %s\n", count, topMachines ? "machines" : "accounts", s);
+
+    free(ranked);
+    free(s);
+    free(topHeap);
+    topHeap = NULL;
+    memset(&topPending, 0, sizeof(struct topEntry));
+    return;
+}//END writeTopReport
+
+void arrowRow(unsigned nameId, long long mobile, long long discount, long long fee, long long net)
+{
+    //Called for every row as it is written, same as topRow()
+
+    //Local Variable(s)
+    struct arrowBatch* batch;
+    const char* text[2];
+    int length[2];
+    int n;
+    int i;
+
+    if(!arrowOutput)
+        return;
+
+    if(arrowRows == NULL)
+        arrowRows = (struct arrowBatch*)calloc(1, sizeof(struct arrowBatch));
+
+    batch = arrowRows;
+    n = batch->count;
+
+    text[0] = nameText(nameId);
+    text[1] = nameText(nameEntry(nameId)->accountId);
+    length[0] = strlen(text[0]);
+    length[1] = accountLength(text[1]);
+
+    for(i = 0; i < 2; i++)
+    {
+        if(batch->offsets[i][n] + length[i] > batch->capacity[i])
+        {
+            batch->capacity[i] = 2 * batch->capacity[i] + length[i] + 4096;
+            batch->text[i] = (char*)realloc(batch->text[i], batch->capacity[i]);
+        }
+
+        memcpy(batch->text[i] + batch->offsets[i][n], text[i], length[i]);
+        batch->offsets[i][n + 1] = batch->offsets[i][n] + length[i];
+    }
+
+    batch->cents[0][n] = mobile;
+    batch->cents[1][n] = discount;
+    batch->cents[2][n] = fee;
+    batch->cents[3][n] = net;
+    batch->cents[4][n] = rowTotal(mobile, discount, fee);
+
+    if(++batch->count == ARROW_BATCH_ROWS)
+        arrowFlush();
+
+    return;
+}//END arrowRow
+
+void arrowFlush()
+{
+    /*
+    Writes the rows held so far as one RecordBatch message. The body is
+    every buffer back to back, each padded to 8 bytes: per utf8 column an
+    (empty) validity bitmap, the offsets & the bytes, per int64 column an
+    (empty) validity bitmap & the values. Nothing is ever null.
+    */
+
+    //Local Variable(s)
+    static const char zeros[8] = { 0 };
+    struct arrowBatch* batch = arrowRows;
+    struct fbBuilder b = { NULL, 0, 0 };
+    long long nodes[ARROW_COLUMNS][2]; //FieldNode: length, null count
+    long long buffers[17][2]; //Buffer: offset, length
+    const void* bodies[17];
+    long long bodyLength = 0;
+    int sizes[5];
+    long long values[5];
+    int at[5];
+    int header, vector;
+    int count = 0;
+    int i;
+
+    if(arrowOut == NULL)
+        arrowSchema();
+
+    for(i = 0; i < ARROW_COLUMNS; i++)
+    {
+        nodes[i][0] = batch->count;
+        nodes[i][1] = 0;
+    }
+
+    for(i = 0; i < ARROW_COLUMNS; i++)//where each buffer goes in the body
+    {
+        buffers[count][0] = bodyLength; //validity, not needed with no nulls
+        buffers[count][1] = 0;
+        bodies[count++] = NULL;
+
+        if(i < 2)
+        {
+            buffers[count][0] = bodyLength;
+            buffers[count][1] = (batch->count + 1) * sizeof(int);
+            bodies[count] = batch->offsets[i];
+            bodyLength += (buffers[count++][1] + 7) & ~7LL;
+
+            buffers[count][0] = bodyLength;
+            buffers[count][1] = batch->offsets[i][batch->count];
+            bodies[count] = batch->text[i];
+            bodyLength += (buffers[count++][1] + 7) & ~7LL;
+        }
+        else
+        {
+            buffers[count][0] = bodyLength;
+            buffers[count][1] = batch->count * sizeof(long long);
+            bodies[count] = batch->cents[i - 2];
+            bodyLength += (buffers[count++][1] + 7) & ~7LL;
+        }
+    }
+
+    //RecordBatch { length, nodes, buffers }, Message points at it
+    header = arrowMessage(&b, 3, bodyLength); //MessageHeader RecordBatch
+    sizes[0] = 8; values[0] = batch->count;
+    sizes[1] = 4; values[1] = 0;
+    sizes[2] = 4; values[2] = 0;
+    fbPatch(&b, header, fbTable(&b, 3, sizes, values, at));
+
+    fbPad(&b, 8); //vectors of structs are 8 aligned, their length sits just before
+    fbPut(&b, zeros, 4);
+    fbPatch(&b, at[1], b.size);
+    vector = ARROW_COLUMNS;
+    fbPut(&b, &vector, 4);
+    fbPut(&b, nodes, sizeof(nodes));
+
+    fbPut(&b, zeros, 4);
+    fbPatch(&b, at[2], b.size);
+    fbPut(&b, &count, 4);
+    fbPut(&b, buffers, count * sizeof(buffers[0]));
+
+    fbPad(&b, 8);
+    i = -1; //continuation marker
+    fwrite(&i, 4, 1, arrowOut);
+    fwrite(&b.size, 4, 1, arrowOut);
+    fwrite(b.data, 1, b.size, arrowOut);
+
+    for(i = 0; i < count; i++)
+    {
+        if(buffers[i][1] > 0)
+        {
+            fwrite(bodies[i], 1, buffers[i][1], arrowOut);
+            fwrite(zeros, 1, (8 - buffers[i][1] % 8) % 8, arrowOut);
+        }
+    }
+
+    free(b.data);
+    batch->count = 0;
+    return;
+}//END arrowFlush
+
+int arrowMessage(struct fbBuilder* b, int headerType, long long bodyLength)
+{
+    /*
+    Starts b with the root offset & a Message { version = V5, header_type,
+    header, bodyLength }. Returns where the header offset is so the caller
+    can point it at the Schema or RecordBatch table that follows.
+    */
+
+    //Local Variable(s)
+    int sizes[4] = { 2, 1, 4, 8 };
+    long long values[4] = { 4, 0, 0, 0 }; //MetadataVersion V5
+    int at[4];
+    int zero = 0;
+
+    values[1] = headerType;
+    values[3] = bodyLength;
+
+    fbPut(b, &zero, 4); //root offset, the message comes right after
+    fbPatch(b, 0, fbTable(b, 4, sizes, values, at));
+
+    return at[2];
+}//END arrowMessage
+
+void arrowSchema()
+{
+    /*
+    Opens <file>_parsed.arrow & writes the Schema message:
+        Display Name, Account: utf8
+        Mobile, Discounts, Fee, Net, Total: int64 (cents)
+    */
+
+    //Local Variable(s)
+    static const char* names[ARROW_COLUMNS] = { "Display Name", "Account", "Mobile", "Discounts", "Fee", "Net", "Total" };
+    struct fbBuilder b = { NULL, 0, 0 };
+    int sizes[6];
+    long long values[6];
+    int at[6];
+    int fieldAt[ARROW_COLUMNS][6];
+    int header, schema, fields, i;
+    char* s = concat(filename, "_parsed.arrow");
+
+    arrowOut = fopen(s, "wb");
+    free(s);
+
+    header = arrowMessage(&b, 1, 0); //MessageHeader Schema, no body
+
+    //Schema { endianness = Little, fields }
+    sizes[0] = 2; values[0] = 0;
+    sizes[1] = 4; values[1] = 0;
+    schema = fbTable(&b, 2, sizes, values, at);
+    fbPatch(&b, header, schema);
+    fields = fbOffsets(&b, ARROW_COLUMNS);
+    fbPatch(&b, at[1], fields);
+
+    for(i = 0; i < ARROW_COLUMNS; i++)//Field { name, nullable, type_type, type, dictionary, children }
+    {
+        sizes[0] = 4; values[0] = 0;
+        sizes[1] = 1; values[1] = 0;
+        sizes[2] = 1; values[2] = (i < 2) ? 5 : 2; //Type Utf8 or Int
+        sizes[3] = 4; values[3] = 0;
+        sizes[4] = 0; values[4] = 0;
+        sizes[5] = 4; values[5] = 0;
+        fbPatch(&b, fields + 4 + 4 * i, fbTable(&b, 6, sizes, values, fieldAt[i]));
+    }
+
+    for(i = 0; i < ARROW_COLUMNS; i++)//what the fields point at
+    {
+        fbPatch(&b, fieldAt[i][0], fbString(&b, names[i]));
+
+        if(i < 2)//Utf8 {}
+        {
+            fbPatch(&b, fieldAt[i][3], fbTable(&b, 0, sizes, values, at));
+        }
+        else//Int { bitWidth = 64, is_signed = true }
+        {
+            sizes[0] = 4; values[0] = 64;
+            sizes[1] = 1; values[1] = 1;
+            fbPatch(&b, fieldAt[i][3], fbTable(&b, 2, sizes, values, at));
+        }
+
+        fbPatch(&b, fieldAt[i][5], fbOffsets(&b, 0)); //no children
+    }
+
+    fbPad(&b, 8);
+    i = -1; //continuation marker
+    fwrite(&i, 4, 1, arrowOut);
+    fwrite(&b.size, 4, 1, arrowOut);
+    fwrite(b.data, 1, b.size, arrowOut);
+
+    free(b.data);
+    return;
+}//END arrowSchema
+
+void finishArrow(const char* base)
+{
+    //Local Variable(s)
+    int marker[2] = { -1, 0 }; //end of stream
+    char* s = concat(base, "_parsed.arrow");
+
+    if(arrowRows == NULL)//no rows at all, still a valid (empty) stream
+        arrowRows = (struct arrowBatch*)calloc(1, sizeof(struct arrowBatch));
+
+    if(arrowRows->count > 0 || arrowOut == NULL)
+        arrowFlush();
+
+    fwrite(marker, 4, 2, arrowOut);
+    fclose(arrowOut);
+    arrowOut = NULL;
+
+    printf("Columnar copy written to %s\n", s);
+
+    free(arrowRows->text[0]);
+    free(arrowRows->text[1]);
+    free(arrowRows);
+    arrowRows = NULL;
+    free(s);
+    return;
+}//END finishArrow
+
+void fbPut(struct fbBuilder* b, const void* bytes, int count)
+{
+    if(b->size + count > b->capacity)
+    {
+        b->capacity = 2 * b->capacity + count + 256;
+        b->data = (unsigned char*)realloc(b->data, b->capacity);
+    }
+
+    memcpy(b->data + b->size, bytes, count);
+    b->size += count;
+    return;
+}//END fbPut
+
+void fbPad(struct fbBuilder* b, int align)
+{
+    static const char zeros[8] = { 0 };
+
+    fbPut(b, zeros, (align - b->size % align) % align);
+    return;
+}//END fbPad
+
+void fbPatch(struct fbBuilder* b, int at, int target)
+{
+    //Flatbuffer offsets are unsigned & relative to where they are stored, so they only point forward
+    unsigned offset = target - at;
+
+    memcpy(b->data + at, &offset, 4);
+    return;
+}//END fbPatch
+
+int fbTable(struct fbBuilder* b, int count, const int* sizes, const long long* values, int* at)
+{
+    /*
+    Writes a vtable followed by its table and returns where the table
+    starts. sizes[i] is 0 for a field left out, otherwise 1, 2, 4 or 8
+    bytes; offsets are 4 byte fields written as 0 & patched later. at[i]
+    gets where field i landed. Fields go biggest first so each one is
+    aligned to its size.
+    */
+
+    //Local Variable(s)
+    unsigned short vtable[2 + ARROW_COLUMNS]; //vtable size, table size, field offsets
+    int start, table, size, i;
+
+    fbPad(b, 2);
+    start = b->size;
+    fbPut(b, vtable, 4 + 2 * count); //filled in once the table is laid out
+
+    fbPad(b, 8);
+    table = b->size;
+    i = table - start; //soffset back to the vtable
+    fbPut(b, &i, 4);
+
+    for(size = 8; size >= 1; size /= 2)
+    {
+        for(i = 0; i < count; i++)
+        {
+            if(sizes[i] != size)
+                continue;
+
+            fbPad(b, size);
+            at[i] = b->size;
+            fbPut(b, &values[i], size); //little endian, the low bytes come first
+        }
+    }
+
+    vtable[0] = 4 + 2 * count;
+    vtable[1] = b->size - table;
+
+    for(i = 0; i < count; i++)
+        vtable[2 + i] = (sizes[i] == 0) ? 0 : at[i] - table;
+
+    memcpy(b->data + start, vtable, 4 + 2 * count);
+    return table;
+}//END fbTable
+
+int fbString(struct fbBuilder* b, const char* str)
+{
+    int length = strlen(str);
+    int start;
+
+    fbPad(b, 4);
+    start = b->size;
+    fbPut(b, &length, 4);
+    fbPut(b, str, length + 1); //flatbuffer strings keep their '\0'
+    return start;
+}//END fbString
+
+int fbOffsets(struct fbBuilder* b, int count)
+{
+    //Vector of count offsets, all 0 for now. Returns where the length is, element i is 4 + 4 * i after it
+    int zero = 0;
+    int start;
+    int i;
+
+    fbPad(b, 4);
+    start = b->size;
+    fbPut(b, &count, 4);
+
+    for(i = 0; i < count; i++)
+        fbPut(b, &zero, 4);
+
+    return start;
+}//END fbOffsets
+
+char* nextToken(char** cursor, char delim)
+{
+    /*
+    Like zstring_strtok() it keeps empty columns, but the position is kept
+    by the caller instead of in a static, so it is safe to use from
+    several threads. An empty column comes back as "".
+    */
+    char* token = *cursor;
+    char* end;
+
+    if(token == NULL)//no tokens left
+        return NULL;
+
+    end = strchr(token, delim);
+
+    if(end == NULL)//last token on the line
+    {
+        *cursor = NULL;
+    }
+    else
+    {
+        *end = '\0';
+        *cursor = end + 1;
+    }
+
+    return token;
+}//END nextToken
+
+char* nextQuoted(char** cursor, char delim)
+{
+    /*
+    nextToken() for quoted fields: a token starting with a quote runs to
+    the closing one, delimiters inside it included, "" is a quote, and it
+    comes back without its quotes. A token with no quote is left to
+    nextToken().
+    */
+    char* token = *cursor;
+    char* in;
+    char* out;
+
+    if(token == NULL || *token != '"')
+        return nextToken(cursor, delim);
+
+    out = token;
+
+    for(in = token + 1; *in != '\0'; in++)
+    {
+        if(*in == '"' && in[1] == '"')//escaped quote
+            in++;
+        else if(*in == '"')//closing quote
+            break;
+
+        *out++ = *in;
+    }
+
+    if(*in == '"')
+        in++;
+
+    while(*in != '\0' && *in != delim)//whatever follows the quote up to the delimiter, normally nothing
+        *out++ = *in++;
+
+    *cursor = (*in == delim) ? in + 1 : NULL;
+    *out = '\0';
+
+    return token;
+}//END nextQuoted
+
+char* skipQuoted(char* cursor, char delim)
+{
+    //strchr(cursor, delim) that steps over a quoted field's delimiters
+    if(*cursor == '"')
+    {
+        for(cursor++; *cursor != '\0'; cursor++)
+        {
+            if(*cursor == '"' && cursor[1] == '"')
+                cursor++;
+            else if(*cursor == '"')
+                break;
+        }
+    }
+
+    return strchr(cursor, delim);
+}//END skipQuoted
+
+long appendLine(FILE* stream, struct lineBuffer* buffer)
+{
+    /*
+    Reads one whole line onto the end of buffer, however long it is,
+    growing buffer when it runs short. fgets() alone hands a long line
+    back in pieces that get misread as columns. Returns where the line
+    starts in buffer->text, or -1 at the end of the file.
+    */
+
+    //Local Variable(s)
+    size_t start = buffer->used;
+    char* grown;
+
+    for(;;)
+    {
+        if(buffer->size - buffer->used < MAX_CSV_LEN)//make room for another piece
+        {
+            grown = (char*)malloc(buffer->size * 2);
+
+            if(grown == NULL)
+            {
+                printf("Error: Not enough memory for a %lu byte line, can not continue.\n", (unsigned long)(buffer->size * 2));
+                exit(1);
+            }
+
+            memcpy(grown, buffer->text, buffer->used);
+
+            if(buffer->onHeap)
+                free(buffer->text);
+
+            buffer->text = grown;
+            buffer->size *= 2;
+            buffer->onHeap = true;
+        }
+
+        if(fgets(buffer->text + buffer->used, buffer->size - buffer->used, stream) == NULL)
+            break;
+
+        buffer->used += strlen(buffer->text + buffer->used);
+
+        if(buffer->used > start && buffer->text[buffer->used - 1] == '\n')//a NUL first byte reads as an empty piece
+            break;
+    }
+
+    if(buffer->used == start)//nothing left
+        return -1;
+
+    buffer->text[buffer->used++] = '\0'; //the terminator stays with the line
+    return start;
+}//END appendLine
+
+char* readLine(FILE* stream, struct lineBuffer* buffer)
+{
+    //Just the next line, over whatever buffer held before
+    buffer->used = 0;
+
+    return (appendLine(stream, buffer) < 0) ? NULL : buffer->text;
+}//END readLine
+
+void freeLine(struct lineBuffer* buffer)
+{
+    if(buffer->onHeap)
+        free(buffer->text);
+
+    buffer->onHeap = false;
+    return;
+}//END freeLine
+
+void setField(struct field* target, const char* text)
+{
+    /*
+    Amounts are a handful of characters, so they live in the row. One that
+    doesn't fit is copied into the field arena instead of running over
+    into the next field.
+    */
+
+    //Local Variable(s)
+    size_t length = strlen(text);
+
+    if(length < FIELD_INLINE)
+    {
+        memcpy(target->text, text, length + 1);
+        target->spill = NULL;
+        return;
+    }
+
+    pthread_mutex_lock(&fieldLock);
+
+    if(length + 1 > FIELD_PAGE)//bigger than a page, gets its own
+    {
+        target->spill = (char*)malloc(length + 1);
+    }
+    else
+    {
+        if(fieldPageUsed + length + 1 > FIELD_PAGE)
+        {
+            fieldPage = (char*)malloc(FIELD_PAGE);
+            fieldPageUsed = 0;
+        }
+
+        target->spill = fieldPage + fieldPageUsed;
+        fieldPageUsed += length + 1;
+    }
+
+    pthread_mutex_unlock(&fieldLock);
+
+    memcpy(target->spill, text, length + 1);
+    target->text[0] = '\0';
+
+    return;
+}//END setField
+
+const char* fieldText(const struct field* source)
+{
+    return (source->spill != NULL) ? source->spill : source->text;
+}//END fieldText
+
+char* concat(const char *s1, const char *s2)
+{
+    char *result = malloc(strlen(s1)+strlen(s2)+1);//+1 for the zero-terminator
+
+    strcpy(result, s1);
+    strcat(result, s2);
+
+    return result;
+}
+
+void stripExtension(char* name)
+{
+    //Longest first, ".csv" is the tail end of the other two
+    int i;
+    int length = strlen(name);
+    int extLength;
+
+    for(i = CODEC_ZSTD; i >= CODEC_NONE; i--)
+    {
+        extLength = strlen(inputExtensions[i]);
+
+        if(length > extLength && strcmp(name + length - extLength, inputExtensions[i]) == 0)
+        {
+            name[length - extLength] = '\0';
+            return;
+        }
+    }
+
+    return;
+}//END stripExtension
+
+bool isLetter(char ch)
+{
+    /*
+       ASCII
+       65(A) to 90(Z)
+       97(a) to 122(z)
+       (difference of 32)
+    */
+        if((64 < ch) && (ch < 91))//lowercase
+        {
+            return true;
+        }
+        else if((96 < ch) && (ch < 123))//uppercase
+        {
+            return true;
+        }
+        else//not a char
+        {
+            return false;
+        }
+}//END isLetter
+
+bool isNextMatch(unsigned currName, unsigned nextName)
+{
+    /*
+    Characters before the last '-' seperator are compared to see if they
+    are from the same account so they can be grouped together. used for
+    totaling amts for a single account with multiple machines.
+
+    The seperator is found once, when the name is interned, and the part
+    before it is interned as well, so two names are from the same account
+    exactly when their account IDs are equal.
+    */
+    return nameEntry(currName)->accountId == nameEntry(nextName)->accountId;
+}//END isNextMatch()
+
+bool moneyExists(struct row* node)
+{
+    //printf("\nMade in to moneyExists and mobileAmt is: (%s)\n", fieldText(&node->mobileAmt)); system("pause");
+    if(moneyCheck(fieldText(&node->mobileAmt)))
+    {
+        //printf("\nCheck #1\n");
+        return true;
+    }
+    else if(moneyCheck(fieldText(&node->discountAmt)))
+    {
+         //printf("\nCheck #2\n");
+         return true;
+    }
+    else if(moneyCheck(fieldText(&node->feeAmt)))
+    {
+        //printf("\nCheck #3\n");
+        return true;
+    }
+    else
+    {
+        //printf("\nCheck#4\n");
+        return false;
+    }
+
+}
+
+bool moneyCheck(const char* amt)
+{
+    //system("pause");
+    //printf("\nCompare Started");
+    int x = strcmp("$0.00", amt);
+    int y = strcmp("$0.00 ", amt);
+    int z = strcmp(" $0.00", amt);
+    //printf("\nCompare Finished\n");
+
+    if(x == 0)
+        return false;
+    else if(y == 0)
+        return false;
+    else if(z == 0)
+        return false;
+    else
+        return true;
+}
+
+void showHead()
+{
+    printf("\nHead Node: \n");
+    printf("\nDisplay Name: (%s)", nameText(head->nameId));
+    printf("\nMobile Amt: (%s)", fieldText(&head->mobileAmt));
+    printf("\nDiscount Amt: (%s)", fieldText(&head->discountAmt));
+    printf("\nFee Amt: (%s)", fieldText(&head->feeAmt));
+    printf("\nNet Amt: (%s)", fieldText(&head->netAmt));
+
+    printf("\nHead Node: \n");
+    printf("\nDisplay Name: (%s)", nameText(head->next->nameId));
+    printf("\nMobile Amt: (%s)", fieldText(&head->next->mobileAmt));
+    printf("\nDiscount Amt: (%s)", fieldText(&head->next->discountAmt));
+    printf("\nFee Amt: (%s)", fieldText(&head->next->feeAmt));
+    printf("\nNet Amt: (%s)", fieldText(&head->next->netAmt));
+    system("pause");
+    return;
+}//END showHead
+
+void showNode(struct row* node)
+{
+    printf("\nNode Information: \n");
+    printf("\nDisplay Name: (%s)", nameText(node->nameId));
+    printf("\nMobile Amt: (%s)", fieldText(&node->mobileAmt));
+    printf("\nDiscount Amt: (%s)", fieldText(&node->discountAmt));
+    printf("\nFee Amt: (%s)", fieldText(&node->feeAmt));
+    printf("\nNet Amt: (%s)\n", fieldText(&node->netAmt));
+    return;
+}//END showNode
+
+void showList()
+{
+    struct row* temp = head;
+    int count = 1;
+
+    while(temp->next != NULL)
+    {
+        printf("\n--------------------------------------");
+        printf("\nNode (%d)", count++);
+        printf("\nDisplay Name:  (%s)",nameText(temp->nameId));
+        printf("\nMobile Amt:    (%s)",fieldText(&temp->mobileAmt));
+        printf("\nFee Amt:       (%s)",fieldText(&temp->feeAmt));
+        printf("\nDiscount Amt:  (%s)",fieldText(&temp->discountAmt));
+        printf("\nNet Amt:       (%s",fieldText(&temp->netAmt));
+
+        if((count % 20) == 0)
+            system("pause");
+
+        temp = temp->next;
+    }
+
+
+    return;
+}//END showList
+
+void countPause(int n)
+{
+    if(n > 240)
+    {
+        system("pause");
+    }
+    return;
+}
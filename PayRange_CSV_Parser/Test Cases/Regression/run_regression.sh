@@ -0,0 +1,152 @@
+#!/bin/sh
+# Regression checks for PayRangeFix.c, run from anywhere:
+#   sh "Test Cases/Regression/run_regression.sh"
+# Builds the parser into a scratch directory, runs the fixtures next to
+# this script plus a few generated inputs through it, and exits 1 if any
+# check fails or the build warns about anything new. Set CC to pick the
+# compiler.
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+SRC="$HERE/../.."
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+FAILED=0
+
+pass() { echo "PASS: $1"; }
+fail() { echo "FAIL: $1"; FAILED=1; }
+
+# prf <args...>, runs the parser in WORK with no console input
+prf() { (cd "$WORK" && ./prf "$@" < /dev/null > last_run.txt 2>&1); }
+
+# same <what> <expected> <actual>
+same() {
+    if cmp -s "$2" "$3"; then pass "$1"; else fail "$1"; diff "$2" "$3" | head -10; fi
+}
+
+# machines <file> <count> <long city>, one record per machine in name order,
+# every 997th one fee-only. The first 50 get the long city in the City
+# column, the Location lines stay short.
+machines() {
+    awk -v count="$2" -v long="$3" 'BEGIN {
+        print "Device ID,Location,City,State,Zip Code,Display Name,Machine ID,Tags,Mobile (#),Mobile (%),Mobile,Cash,Card,Total,Fee,Discounts,Loyalty,Promotions (!),Net"
+        for(i = 0; i < count; i++)
+        {
+            city = (long != "" && i < 50) ? long : "Orlando"
+            amounts = (i % 997 == 5) ? "$0.00,$1.00,$0.00,$1.00,$0.05,$0.00,$0.00,$0.00,-$0.05" \
+                                     : sprintf("$%d.25,$0.00,$0.00,$%d.25,$0.05,$0.10,$0.00,$0.00,$%d.10", i % 7 + 1, i % 7 + 1, i % 7 + 1)
+            printf "%d,\"Breakroom\n1 Main St\nOrlando\nFL\n32801\n\",%s,FL,32801,Account %05d - Snack Machine %d,M%06d,promo,1,,%s\n",
+                   10000000 + i, city, int(i / 3), i % 3, i, amounts
+        }
+    }' > "$WORK/$1.csv"
+}
+
+echo "Building..."
+if ! ${CC:-cc} -std=gnu11 -O2 -Wall -Wextra -isystem "$SRC/Source Code" "$SRC/PayRangeFix.c" -o "$WORK/prf" -lpthread 2> "$WORK/build.txt"; then
+    cat "$WORK/build.txt"
+    echo "FAIL: build"
+    exit 1
+fi
+
+# gets() in verifyFileName() is the only warning there is
+if grep "warning" "$WORK/build.txt" | grep -v "gets" > /dev/null; then
+    cat "$WORK/build.txt"
+    fail "build without new warnings"
+else
+    pass "build without new warnings"
+fi
+
+cp "$HERE"/export_week.csv "$HERE"/percent.csv "$HERE"/fees_week1.csv "$HERE"/fees_week2.csv "$HERE"/quoted_week1.csv "$HERE"/quoted_week2.csv "$WORK"/
+
+# A file just like PayRange exports it (CRLF, the Location starting on its
+# own line) goes through the fixed layout parser, not the column plan
+for mode in "" "--stream" "--pipeline"; do
+    rm -f "$WORK/export_week_parsed.csv"
+    prf $mode export_week
+
+    if grep -q "Parser: *fixed PayRange layout" "$WORK/last_run.txt"; then
+        same "real export ${mode:-(default)}" "$HERE/export_expected.csv" "$WORK/export_week_parsed.csv"
+    else
+        fail "real export ${mode:-(default)}, not parsed as the fixed PayRange layout"; grep "Parser:" "$WORK/last_run.txt"
+    fi
+done
+
+# A '%' in a Display Name is text, not a printf format, in every writer
+for mode in "" "--stream" "--pipeline"; do
+    rm -f "$WORK/percent_parsed.csv"
+    prf $mode percent
+    same "'%' in Display Name ${mode:-(default)}" "$HERE/percent_expected.csv" "$WORK/percent_parsed.csv"
+done
+
+# Fee-only rows survive --merge, add up across weeks and reach the Totals
+prf fees_week1 fees_week2
+prf --merge merged.csv fees_week1_parsed.csv fees_week2_parsed.csv
+same "fee-only rows through --merge" "$HERE/merged_expected.csv" "$WORK/merged.csv"
+
+# Display Names with a comma or a quote are quoted and read back whole by --merge
+prf quoted_week1 quoted_week2
+prf --merge quoted.csv quoted_week1_parsed.csv quoted_week2_parsed.csv
+same "quoted Display Names through --merge" "$HERE/quoted_expected.csv" "$WORK/quoted.csv"
+
+# A 700 character City in a --group-by key
+long=$(awk 'BEGIN { while(length(s) < 700) s = s "X"; print s }')
+machines longcity 300 "$long"
+if prf --group-by city,name longcity && grep -q "^City/Display Name,$long | Account 00000 - Snack Machine 0,1," "$WORK/longcity_rollup.csv"; then
+    pass "long value with --group-by"
+else
+    fail "long value with --group-by"; tail -3 "$WORK/last_run.txt"
+fi
+
+# More Machine IDs than the first dictionary size (65536)
+machines machines 100000 ""
+if prf --group-by machine machines && [ "$(grep -c '^Machine ID,M' "$WORK/machines_rollup.csv")" -eq 100000 ]; then
+    pass "100000 distinct Machine IDs"
+else
+    fail "100000 distinct Machine IDs"; tail -3 "$WORK/last_run.txt"
+fi
+
+# Every way of running the same file writes the same bytes. The second
+# --index run reuses the .csv.idx the first one built.
+machines modes 60000 ""
+prf modes
+cp "$WORK/modes_parsed.csv" "$WORK/reference.csv"
+
+for mode in "--threads 1" "--threads 4" "--stream" "--pipeline" "--pipeline --stream" \
+            "--mem-budget 1" "--threads 4 --mem-budget 1" "--pipeline --mem-budget 1" "--index" "--index"; do
+    rm -f "$WORK/modes_parsed.csv"
+    prf $mode modes
+    same "identical output with $mode" "$WORK/reference.csv" "$WORK/modes_parsed.csv"
+
+    case "$mode" in
+        *--mem-budget*)
+            runs=$(sed -n 's/^ *Sorted Runs: *\([0-9]*\).*/\1/p' "$WORK/last_run.txt")
+            if [ "${runs:-0}" -gt 0 ]; then
+                pass "$mode spilled $runs sorted runs"
+            else
+                fail "$mode spilled no sorted runs"
+            fi
+            ;;
+    esac
+done
+
+# --resume after a run killed right after its first checkpoint
+rm -f "$WORK/modes_parsed.csv" "$WORK/modes.ckpt"
+(cd "$WORK" && exec ./prf --stream --checkpoint-mb 1 modes < /dev/null > /dev/null 2>&1) &
+while [ ! -s "$WORK/modes.ckpt" ] && kill -0 $! 2> /dev/null; do :; done
+kill -9 $! 2> /dev/null
+wait
+
+if [ ! -s "$WORK/modes.ckpt" ]; then
+    fail "identical output with --resume, the run ended before its first checkpoint"
+elif prf --resume modes && grep -q "resumed at input byte" "$WORK/last_run.txt"; then
+    same "identical output with --resume" "$WORK/reference.csv" "$WORK/modes_parsed.csv"
+else
+    fail "identical output with --resume, it started over"
+fi
+
+if [ "$FAILED" -ne 0 ]; then
+    echo "Some checks FAILED."
+    exit 1
+fi
+
+echo "All checks passed."
+exit 0